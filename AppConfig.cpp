@@ -35,6 +35,36 @@ int GetRequiredInt(const toml::table& table, const char* key)
     return static_cast<int>(*value);
 }
 
+int GetOptionalInt(const toml::table& table, const char* key, int fallback)
+{
+    auto node = table[key];
+    if (!node)
+        return fallback;
+
+    return GetRequiredInt(table, key);
+}
+
+std::vector<std::string> GetOptionalStringArray(const toml::table& table, const char* key)
+{
+    std::vector<std::string> values;
+    auto node = table[key];
+    if (!node)
+        return values;
+
+    const toml::array* array = node.as_array();
+    if (!array)
+        throw std::runtime_error(std::string("Invalid string array key: ") + key);
+
+    for (const toml::node& element : *array)
+    {
+        auto value = element.value<std::string>();
+        if (!value)
+            throw std::runtime_error(std::string("Invalid string array key: ") + key);
+        values.push_back(*value);
+    }
+    return values;
+}
+
 double GetRequiredNumber(const toml::table& table, const char* key)
 {
     auto node = table[key];
@@ -47,6 +77,15 @@ double GetRequiredNumber(const toml::table& table, const char* key)
 
     throw std::runtime_error(std::string("Missing or invalid numeric key: ") + key);
 }
+
+double GetOptionalNumber(const toml::table& table, const char* key, double fallback)
+{
+    auto node = table[key];
+    if (!node)
+        return fallback;
+
+    return GetRequiredNumber(table, key);
+}
 }  // namespace
 
 std::wstring GetConfigPathFromArgsOrFail()
@@ -108,6 +147,19 @@ AppConfig LoadConfigFromTomlOrFail(const std::wstring& path)
     if (auto behaviour = table["behaviour"].value<std::string>())
         config.behaviour = *behaviour;
 
+    if (auto toneMap = table["tone_map"].value<std::string>())
+        config.tone_map = *toneMap;
+    config.tone_map_exposure = GetOptionalNumber(table, "tone_map_exposure", config.tone_map_exposure);
+    config.stream_port = GetOptionalInt(table, "stream_port", config.stream_port);
+    config.stream_tile_size = GetOptionalInt(table, "stream_tile_size", config.stream_tile_size);
+    config.stream_keyframe_interval = GetOptionalInt(table, "stream_keyframe_interval", config.stream_keyframe_interval);
+
+    if (auto presenter = table["presenter"].value<std::string>())
+        config.presenter = *presenter;
+    if (auto scalingFilter = table["scaling_filter"].value<std::string>())
+        config.scaling_filter = *scalingFilter;
+    config.governor_levels = GetOptionalStringArray(table, "governor_levels");
+
     return config;
 }
 
@@ -127,6 +179,34 @@ void ValidateConfigOrFail(const AppConfig& config)
         throw std::runtime_error("frames_per_second must be a finite number > 0.");
     if (!config.behaviour.empty() && config.behaviour != "crosshairs" && config.behaviour != "flex")
         throw std::runtime_error("behaviour must be \"crosshairs\", \"flex\", or omitted.");
+    if (!config.tone_map.empty() && config.tone_map != "clamp" && config.tone_map != "reinhard" && config.tone_map != "aces")
+        throw std::runtime_error("tone_map must be \"clamp\", \"reinhard\", \"aces\", or omitted.");
+    if (!std::isfinite(config.tone_map_exposure) || config.tone_map_exposure <= 0.0)
+        throw std::runtime_error("tone_map_exposure must be a finite number > 0.");
+    if (config.stream_port < 0 || config.stream_port > 65535)
+        throw std::runtime_error("stream_port must be between 0 and 65535.");
+    if (config.stream_tile_size < 8 || config.stream_tile_size > 1024)
+        throw std::runtime_error("stream_tile_size must be between 8 and 1024.");
+    if (config.stream_keyframe_interval < 1)
+        throw std::runtime_error("stream_keyframe_interval must be >= 1.");
+    if (!config.presenter.empty() && config.presenter != "gdi" && config.presenter != "null")
+        throw std::runtime_error("presenter must be \"gdi\", \"null\", or omitted.");
+    if (!config.scaling_filter.empty() && config.scaling_filter != "nearest" && config.scaling_filter != "halftone")
+        throw std::runtime_error("scaling_filter must be \"nearest\", \"halftone\", or omitted.");
+    for (size_t i = 0; i < config.governor_levels.size(); ++i)
+    {
+        const std::string& level = config.governor_levels[i];
+        if (level != "cheap_scaling" && level != "skip_overlay" && level != "reduce_rate")
+            throw std::runtime_error("governor_levels entries must be \"cheap_scaling\", \"skip_overlay\", or \"reduce_rate\".");
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (config.governor_levels[j] == level)
+                throw std::runtime_error("governor_levels must not repeat an entry.");
+        }
+        // Nearest is already the cheapest filter, so the step would spend a level doing nothing.
+        if (level == "cheap_scaling" && config.scaling_filter != "halftone")
+            throw std::runtime_error("governor_levels may only include \"cheap_scaling\" when scaling_filter = \"halftone\".");
+    }
 
     const int captureWidth = static_cast<int>(static_cast<double>(config.display_width) / config.zoom_factor);
     const int captureHeight = static_cast<int>(static_cast<double>(config.display_height) / config.zoom_factor);
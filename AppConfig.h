@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 struct AppConfig
 {
@@ -11,6 +12,14 @@ struct AppConfig
     double zoom_factor;
     double frames_per_second;
     std::string behaviour;  // optional: "crosshairs" or empty
+    std::string tone_map;   // optional: "clamp", "reinhard", "aces" or empty (reinhard); HDR desktops only
+    double tone_map_exposure = 1.0;  // optional: scRGB multiplier before tone mapping
+    int stream_port = 0;             // optional: loopback port for the tile stream; 0 disables it
+    int stream_tile_size = 64;       // optional: tile edge in pixels
+    int stream_keyframe_interval = 120;  // optional: frames between keyframes
+    std::string presenter;     // optional: "gdi", "null" or empty (gdi)
+    std::string scaling_filter;  // optional: "nearest", "halftone" or empty (nearest)
+    std::vector<std::string> governor_levels;  // optional: degradation steps in order; empty disables the governor
 };
 
 std::wstring GetConfigPathFromArgsOrFail();
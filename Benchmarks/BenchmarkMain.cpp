@@ -0,0 +1,38 @@
+// BenchmarkMain.cpp : runs every registered benchmark, or only those whose name contains argv[1].
+
+#include "BenchmarkSupport.h"
+
+#include <cstring>
+#include <exception>
+
+std::vector<BenchmarkCase>& BenchmarkRegistry()
+{
+    static std::vector<BenchmarkCase> registry;
+    return registry;
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int exitCode = 0;
+
+    for (const BenchmarkCase& benchmark : BenchmarkRegistry())
+    {
+        if (filter && std::strstr(benchmark.name, filter) == nullptr)
+            continue;
+
+        std::printf("%s\n", benchmark.name);
+        std::fflush(stdout);
+        try
+        {
+            benchmark.run();
+        }
+        catch (const std::exception& ex)
+        {
+            std::printf("  failed: %s\n", ex.what());
+            exitCode = 1;
+        }
+        std::fflush(stdout);
+    }
+    return exitCode;
+}
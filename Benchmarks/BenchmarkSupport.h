@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Minimal self-registering benchmark harness for FastMagStream.Benchmarks. Each BENCHMARK runs
+// once and prints its own results; run from a Release build.
+
+struct BenchmarkCase
+{
+    const char* name;
+    void (*run)();
+};
+
+std::vector<BenchmarkCase>& BenchmarkRegistry();
+
+struct BenchmarkRegistrar
+{
+    BenchmarkRegistrar(const char* name, void (*run)()) { BenchmarkRegistry().push_back({ name, run }); }
+};
+
+#define BENCHMARK(name)                                               \
+    static void name();                                               \
+    static const BenchmarkRegistrar name##_registrar(#name, &name);   \
+    static void name()
+
+struct TimingSummary
+{
+    double median_ms;
+    double min_ms;
+    double max_ms;
+};
+
+// Runs body once to warm caches, then times it iterations times.
+template <typename Body>
+TimingSummary MeasureMilliseconds(int iterations, Body&& body)
+{
+    using Clock = std::chrono::steady_clock;
+    body();
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto start = Clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return TimingSummary{ samples[samples.size() / 2], samples.front(), samples.back() };
+}
+
+inline void PrintTiming(const char* label, const TimingSummary& timing)
+{
+    std::printf("  %-40s median %8.2f ms  min %8.2f ms  max %8.2f ms\n", label, timing.median_ms, timing.min_ms, timing.max_ms);
+}
@@ -0,0 +1,123 @@
+// CaptureLoopBenchmark.cpp : RunCaptureLoop headless and unpaced, once with a NullPresenter and once
+// with a MemoryPresenter, so the difference is the present cost. Needs an interactive desktop session;
+// duplication only delivers frames when the desktop changes, so keep something moving on screen.
+
+#include "BenchmarkSupport.h"
+
+#include "CaptureEngine.h"
+#include "Presenter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr int kDisplayWidth = 1920;
+constexpr int kDisplayHeight = 1080;
+constexpr auto kRunTime = std::chrono::seconds(3);
+
+// Times each Present of the wrapped presenter. Only the capture thread calls in, and the samples
+// are read after it has been joined.
+class TimedPresenter : public Presenter
+{
+public:
+    explicit TimedPresenter(std::shared_ptr<Presenter> inner)
+        : inner_(std::move(inner))
+    {
+    }
+
+    void Present(const CaptureFrameContext& frame) override
+    {
+        const auto start = std::chrono::steady_clock::now();
+        inner_->Present(frame);
+        present_ms_.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    void PresentBlank() override { inner_->PresentBlank(); }
+    void SetScalingFilter(ScalingFilter filter) override { inner_->SetScalingFilter(filter); }
+
+    const std::vector<double>& PresentMilliseconds() const { return present_ms_; }
+
+private:
+    std::shared_ptr<Presenter> inner_;
+    std::vector<double> present_ms_;
+};
+
+struct LoopRun
+{
+    int status;
+    double seconds;
+    std::vector<double> present_ms;
+};
+
+LoopRun RunUnpaced(std::shared_ptr<Presenter> presenter)
+{
+    AppConfig config{};
+    config.display_width = kDisplayWidth;
+    config.display_height = kDisplayHeight;
+    config.record_width = kDisplayWidth;
+    config.record_height = kDisplayHeight;
+    config.zoom_factor = 2.0;
+    config.frames_per_second = 60.0;  // only paces the paused branch once unpaced
+
+    const auto timed = std::make_shared<TimedPresenter>(std::move(presenter));
+    CaptureRuntimeOptions options{};
+    options.presenter = timed;
+    options.unpaced = true;
+
+    std::atomic<bool> running{ true };
+    int status = -1;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread loop([&]() { status = RunCaptureLoop(nullptr, config, running, options); });
+    std::this_thread::sleep_for(kRunTime);
+    running = false;
+    loop.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return LoopRun{ status, seconds, timed->PresentMilliseconds() };
+}
+
+void ReportRun(const LoopRun& run, std::uint64_t presentedFrames)
+{
+    if (run.status == kCaptureStatusInitFailure)
+    {
+        std::printf("  skipped: desktop duplication is unavailable in this session\n");
+        return;
+    }
+    if (run.status != kCaptureStatusSuccess)
+        throw std::runtime_error("capture loop stopped with status " + std::to_string(run.status));
+    if (presentedFrames == 0)
+    {
+        std::printf("  skipped: the desktop did not change during the run\n");
+        return;
+    }
+
+    std::vector<double> sorted = run.present_ms;
+    std::sort(sorted.begin(), sorted.end());
+    const double totalMs = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+    std::printf("  %llu frames in %.2f s (%.1f fps)\n", static_cast<unsigned long long>(presentedFrames), run.seconds,
+        static_cast<double>(presentedFrames) / run.seconds);
+    std::printf("  Present  mean %6.3f ms  median %6.3f ms  max %6.3f ms\n", totalMs / static_cast<double>(sorted.size()),
+        sorted[sorted.size() / 2], sorted.back());
+}
+}  // namespace
+
+BENCHMARK(CaptureLoop_UnpacedNullPresenter)
+{
+    const auto presenter = std::make_shared<NullPresenter>();
+    const LoopRun run = RunUnpaced(presenter);
+    ReportRun(run, presenter->PresentedFrames());
+}
+
+BENCHMARK(CaptureLoop_UnpacedMemoryPresenter)
+{
+    const LoopRun run = RunUnpaced(std::make_shared<MemoryPresenter>(kDisplayWidth, kDisplayHeight, 2));
+    ReportRun(run, run.present_ms.size());
+}
@@ -0,0 +1,265 @@
+// TileStreamBenchmark.cpp : TileStreamSink end to end on one machine. A synthetic desktop is submitted
+// at 60 fps and as fast as possible to an in-process loopback client that decodes every frame.
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "BenchmarkSupport.h"
+
+#include "StreamProtocol.h"
+#include "TileStreamSink.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int kFirstPort = 50598;  // one port per run so the second never waits on the first
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+constexpr int kTileSize = 64;
+constexpr int kKeyframeInterval = 120;
+constexpr int kFrames = 600;
+constexpr auto kWarmupTimeout = std::chrono::seconds(5);
+
+// A static desktop with a 320x240 block sliding across it and a blinking caret, so each delta frame
+// carries a realistic handful of changed tiles.
+class SyntheticDesktop
+{
+public:
+    SyntheticDesktop()
+        : pixels_(static_cast<std::size_t>(kWidth) * kHeight)
+    {
+        for (int y = 0; y < kHeight; ++y)
+        {
+            for (int x = 0; x < kWidth; ++x)
+                pixels_[static_cast<std::size_t>(y) * kWidth + x] = ((x / 8 + y / 16) % 7 == 0) ? 0xFF1E1E1Eu : 0xFFF3F3F3u;
+        }
+        background_ = pixels_;
+    }
+
+    CaptureFrameContext Frame(int index)
+    {
+        pixels_ = background_;
+        const int blockX = (index * 12) % (kWidth - 320);
+        for (int y = 400; y < 640; ++y)
+        {
+            std::uint32_t* row = pixels_.data() + static_cast<std::size_t>(y) * kWidth;
+            for (int x = blockX; x < blockX + 320; ++x)
+                row[x] = 0xFF000000u | static_cast<std::uint32_t>((x * 7 + y * 3 + index) & 0xFF) * 0x010100u;
+        }
+        if ((index / 30) % 2 == 0)
+        {
+            for (int y = 100; y < 120; ++y)
+                pixels_[static_cast<std::size_t>(y) * kWidth + 200] = 0xFF000000u;
+        }
+        return CaptureFrameContext{ nullptr, pixels_.data(), kWidth * 4, kWidth, kHeight };
+    }
+
+private:
+    std::vector<std::uint32_t> pixels_;
+    std::vector<std::uint32_t> background_;
+};
+
+struct ClientResults
+{
+    std::atomic<std::uint64_t> frames{ 0 };
+    std::atomic<std::uint64_t> keyframes{ 0 };
+    std::atomic<std::uint64_t> tiles{ 0 };
+    std::atomic<std::uint64_t> bytes{ 0 };
+    std::atomic<bool> decode_error{ false };
+    std::atomic<bool> finished{ false };  // RunClient has returned
+    std::vector<double> latency_ms;
+};
+
+void ReadFrames(SOCKET socket, ClientResults& results)
+{
+    std::vector<std::uint8_t> payload;
+    std::vector<std::uint8_t> frame(static_cast<std::size_t>(kWidth) * kHeight * 4);
+    for (;;)
+    {
+        StreamFrameHeader header;
+        if (!RecvAll(socket, reinterpret_cast<std::uint8_t*>(&header), sizeof(header)))
+            return;
+        if (header.magic != kStreamMagic || header.version != kStreamVersion ||
+            header.width != static_cast<std::uint32_t>(kWidth) || header.height != static_cast<std::uint32_t>(kHeight))
+        {
+            results.decode_error = true;
+            return;
+        }
+        payload.resize(header.payload_bytes);
+        if (!RecvAll(socket, payload.data(), payload.size()))
+            return;
+        if (!DecodeFrame(header, payload, frame))
+        {
+            results.decode_error = true;
+            return;
+        }
+
+        results.latency_ms.push_back(static_cast<double>(StreamClockMicroseconds() - header.capture_time_us) / 1000.0);
+        results.keyframes += (header.flags & kStreamFlagKeyframe) ? 1 : 0;
+        results.tiles += header.tile_count;
+        results.bytes += sizeof(header) + payload.size();
+        ++results.frames;
+    }
+}
+
+// Reads and decodes frames until the sink closes the connection or the stream is malformed.
+void RunClient(SOCKET socket, ClientResults& results)
+{
+    ReadFrames(socket, results);
+    results.finished = true;
+}
+
+// Holds a Winsock reference across the runs, so the client socket outlives each sink's WSACleanup.
+class WinsockSession
+{
+public:
+    WinsockSession()
+    {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+            throw std::runtime_error("WSAStartup failed");
+    }
+    ~WinsockSession() { WSACleanup(); }
+    WinsockSession(const WinsockSession&) = delete;
+    WinsockSession& operator=(const WinsockSession&) = delete;
+};
+
+void RunStream(const char* label, int port, bool paced)
+{
+    TileStreamSink sink(TileStreamOptions{ port, kTileSize, kKeyframeInterval });
+    if (!sink.Start())
+        throw std::runtime_error("cannot listen on 127.0.0.1:" + std::to_string(port));
+
+    SOCKET socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<u_short>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (socket == INVALID_SOCKET || connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR)
+    {
+        if (socket != INVALID_SOCKET)
+            closesocket(socket);
+        throw std::runtime_error("cannot connect to the sink");
+    }
+
+    ClientResults results;
+    std::thread client(RunClient, socket, std::ref(results));
+    SyntheticDesktop desktop;
+
+    // Closing our end first wakes the client's recv; the sink's own Winsock reference goes in Stop.
+    const auto finishClient = [&]() {
+        shutdown(socket, SD_BOTH);
+        closesocket(socket);
+        sink.Stop();
+        client.join();
+    };
+
+    // SubmitFrame is a no-op until the sender has accepted, so warm up until the first frame arrives.
+    int index = 0;
+    const auto warmupDeadline = std::chrono::steady_clock::now() + kWarmupTimeout;
+    while (results.frames.load() == 0)
+    {
+        if (results.finished.load() || std::chrono::steady_clock::now() >= warmupDeadline)
+        {
+            finishClient();
+            throw std::runtime_error(results.decode_error.load()
+                ? "the client rejected the first frame"
+                : "no frame reached the client within the warmup timeout");
+        }
+        sink.SubmitFrame(desktop.Frame(index++));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    // Let any warmup frame still in flight land, so the snapshots below describe the same frames.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const std::uint64_t warmupFrames = results.frames.load();
+    const std::uint64_t warmupDropped = sink.DroppedFrames();
+    const std::uint64_t warmupKeyframes = results.keyframes.load();
+    const std::uint64_t warmupTiles = results.tiles.load();
+    const std::uint64_t warmupBytes = results.bytes.load();
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> submitMs;
+    submitMs.reserve(kFrames);
+    const auto start = Clock::now();
+    for (int i = 0; i < kFrames; ++i)
+    {
+        const CaptureFrameContext frame = desktop.Frame(index++);
+        const auto submitStart = Clock::now();
+        sink.SubmitFrame(frame);
+        submitMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - submitStart).count());
+        if (paced)
+            std::this_thread::sleep_until(start + std::chrono::microseconds(16667) * (i + 1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));  // let the last frame drain
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    finishClient();
+
+    const std::uint64_t frames = results.frames.load() - warmupFrames;
+    std::vector<double> latency(results.latency_ms.begin() + static_cast<std::ptrdiff_t>(warmupFrames), results.latency_ms.end());
+    std::sort(latency.begin(), latency.end());
+    std::sort(submitMs.begin(), submitMs.end());
+    const auto percentile = [](const std::vector<double>& sorted, double p) {
+        return sorted.empty() ? 0.0 : sorted[static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1))];
+    };
+
+    std::printf(" %s\n", label);
+    std::printf("  submitted %d, delivered %llu (%.1f fps), dropped in mailbox %llu, keyframes %llu%s\n",
+        kFrames, static_cast<unsigned long long>(frames), static_cast<double>(frames) / seconds,
+        static_cast<unsigned long long>(sink.DroppedFrames() - warmupDropped),
+        static_cast<unsigned long long>(results.keyframes.load() - warmupKeyframes), results.decode_error.load() ? ", DECODE ERROR" : "");
+    std::printf("  %.2f MB/s, %.1f tiles/frame\n",
+        static_cast<double>(results.bytes.load() - warmupBytes) / seconds / (1024.0 * 1024.0),
+        static_cast<double>(results.tiles.load() - warmupTiles) / static_cast<double>(std::max<std::uint64_t>(frames, 1)));
+    std::printf("  SubmitFrame      median %6.3f ms  p99 %6.3f ms\n", percentile(submitMs, 0.5), percentile(submitMs, 0.99));
+    std::printf("  submit->decoded  median %6.3f ms  p99 %6.3f ms  max %6.3f ms\n",
+        percentile(latency, 0.5), percentile(latency, 0.99), latency.empty() ? 0.0 : latency.back());
+}
+}  // namespace
+
+BENCHMARK(TileStream_Loopback1080p)
+{
+    std::printf(" %dx%d, %d px tiles, keyframe every %d, %d frames\n", kWidth, kHeight, kTileSize, kKeyframeInterval, kFrames);
+    const WinsockSession winsock;
+    RunStream("paced at 60 fps", kFirstPort, true);
+    RunStream("unpaced (sender-bound)", kFirstPort + 1, false);
+}
+
+BENCHMARK(StreamProtocol_EncodeKeyframe1080p)
+{
+    // Encoder cost alone: every tile of one frame, as for a keyframe.
+    SyntheticDesktop desktop;
+    const CaptureFrameContext frame = desktop.Frame(0);
+    const auto* pixels = static_cast<const std::uint8_t*>(frame.pixels);
+    std::vector<std::uint8_t> out;
+    out.reserve(static_cast<std::size_t>(kWidth) * kHeight * 4 * 2);
+
+    std::size_t encodedBytes = 0;
+    const TimingSummary timing = MeasureMilliseconds(50, [&] {
+        out.clear();
+        for (int y = 0; y < kHeight; y += kTileSize)
+        {
+            for (int x = 0; x < kWidth; x += kTileSize)
+            {
+                EncodeTile(pixels + (static_cast<std::size_t>(y) * kWidth + x) * 4, kWidth * 4,
+                    std::min(kTileSize, kWidth - x), std::min(kTileSize, kHeight - y), out);
+            }
+        }
+        encodedBytes = out.size();
+    });
+    PrintTiming("EncodeTile, all tiles", timing);
+    std::printf("  %.2f MB -> %.2f MB\n", static_cast<double>(kWidth) * kHeight * 4 / (1024.0 * 1024.0),
+        static_cast<double>(encodedBytes) / (1024.0 * 1024.0));
+}
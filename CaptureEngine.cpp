@@ -3,21 +3,95 @@
 #endif
 
 #include "CaptureEngine.h"
+#include "PixelConversion.h"
+#include "Presenter.h"
+#include "QualityGovernor.h"
 
 #include <Windows.h>
 #include <chrono>
-#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
 #include <thread>
 #include <d3d11.h>
 #include <dxgi1_2.h>
+#include <dxgi1_5.h>
 
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
 
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void Log(const CaptureRuntimeOptions& options, const std::string& line)
+{
+    if (options.log)
+        options.log(line);
+    else
+        OutputDebugStringA((line + "\n").c_str());
+}
+
+// DuplicateOutput1 returns E_ACCESSDENIED unless the caller is per-monitor DPI aware. Only the
+// capture thread is switched, and only for the call. SetThreadDpiAwarenessContext is resolved at
+// runtime so the exe still starts on Windows 8, where DuplicateOutput1 is unavailable anyway.
+class ScopedPerMonitorDpiAwareness
+{
+public:
+    ScopedPerMonitorDpiAwareness()
+    {
+        using SetThreadDpiAwarenessContextFn = DPI_AWARENESS_CONTEXT(WINAPI*)(DPI_AWARENESS_CONTEXT);
+        HMODULE user32 = GetModuleHandleW(L"user32.dll");
+        if (user32)
+            set_context_ = reinterpret_cast<SetThreadDpiAwarenessContextFn>(GetProcAddress(user32, "SetThreadDpiAwarenessContext"));
+        if (set_context_)
+            previous_ = set_context_(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+    }
+
+    ~ScopedPerMonitorDpiAwareness()
+    {
+        if (set_context_ && previous_)
+            set_context_(previous_);
+    }
+
+    ScopedPerMonitorDpiAwareness(const ScopedPerMonitorDpiAwareness&) = delete;
+    ScopedPerMonitorDpiAwareness& operator=(const ScopedPerMonitorDpiAwareness&) = delete;
+
+private:
+    DPI_AWARENESS_CONTEXT(WINAPI* set_context_)(DPI_AWARENESS_CONTEXT) = nullptr;
+    DPI_AWARENESS_CONTEXT previous_ = nullptr;
+};
+}  // namespace
+
 int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& running, const CaptureRuntimeOptions& options)
 {
     const auto frameDelay = std::chrono::duration<double, std::milli>(ComputeFrameDelayMs(config));
     const bool useDynamicZoom = static_cast<bool>(options.get_zoom_factor);
+    // GetDC(nullptr) is the whole screen, so without a window there is nothing safe to fall back to.
+    if (!options.presenter && !window)
+        return kCaptureStatusInitFailure;
+    const std::shared_ptr<Presenter> presenter = options.presenter
+        ? options.presenter
+        : std::make_shared<GdiPresenter>(window, config.display_width, config.display_height);
+    const ScalingFilter configuredFilter = ScalingFilterFromName(config.scaling_filter);
+    presenter->SetScalingFilter(configuredFilter);
+
+    std::optional<QualityGovernor> governor;
+    if (!config.governor_levels.empty())
+    {
+        QualityGovernorSettings settings{};
+        settings.frame_budget_ms = ComputeFrameDelayMs(config);
+        for (const std::string& level : config.governor_levels)
+            settings.levels.push_back(DegradationStepFromName(level));
+        governor.emplace(std::move(settings), options.log);
+    }
+    QualityState quality{};
+    std::uint64_t presentedFrames = 0;
 
     ID3D11Device* pDevice = nullptr;
     ID3D11DeviceContext* pContext = nullptr;
@@ -45,8 +119,31 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
     hr = pOutput->QueryInterface(__uuidof(IDXGIOutput1), reinterpret_cast<void**>(&pOutput1));
     if (FAILED(hr) || !pOutput1) { pOutput->Release(); pContext->Release(); pDevice->Release(); return kCaptureStatusInitFailure; }
 
+    // Prefer the desktop's native format so HDR and 10-bit modes are converted by us rather than
+    // flattened by the OS; fall back to the legacy BGRA-only duplication when unavailable.
     IDXGIOutputDuplication* pDuplication = nullptr;
-    hr = pOutput1->DuplicateOutput(pDevice, &pDuplication);
+    IDXGIOutput5* pOutput5 = nullptr;
+    hr = pOutput1->QueryInterface(__uuidof(IDXGIOutput5), reinterpret_cast<void**>(&pOutput5));
+    if (SUCCEEDED(hr) && pOutput5)
+    {
+        const DXGI_FORMAT supportedFormats[] = {
+            DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R10G10B10A2_UNORM, DXGI_FORMAT_B8G8R8A8_UNORM };
+        HRESULT duplicateHr;
+        {
+            ScopedPerMonitorDpiAwareness dpiAwareness;
+            duplicateHr = pOutput5->DuplicateOutput1(pDevice, 0, ARRAYSIZE(supportedFormats), supportedFormats, &pDuplication);
+        }
+        pOutput5->Release();
+        if (FAILED(duplicateHr))
+        {
+            char line[128];
+            std::snprintf(line, sizeof(line), "DuplicateOutput1 failed (hr=0x%08lX); falling back to 8-bit DuplicateOutput.",
+                static_cast<unsigned long>(duplicateHr));
+            Log(options, line);
+        }
+    }
+    if (!pDuplication)
+        hr = pOutput1->DuplicateOutput(pDevice, &pDuplication);
     pOutput1->Release();
     pOutput->Release();
     if (FAILED(hr) || !pDuplication) { pContext->Release(); pDevice->Release(); return kCaptureStatusInitFailure; }
@@ -55,6 +152,16 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
     pDuplication->GetDesc(&dupDesc);
     const int desktopWidth = dupDesc.ModeDesc.Width;
     const int desktopHeight = dupDesc.ModeDesc.Height;
+    {
+        char line[96];
+        std::snprintf(line, sizeof(line), "Desktop duplication: %dx%d, DXGI format %d.",
+            desktopWidth, desktopHeight, static_cast<int>(dupDesc.ModeDesc.Format));
+        Log(options, line);
+    }
+
+    const ToneMapSettings toneMap{ ToneMapCurveFromName(config.tone_map), static_cast<float>(config.tone_map_exposure) };
+    const PixelConverter converter(dupDesc.ModeDesc.Format, toneMap);
+    if (!converter.IsSupported()) { pDuplication->Release(); pContext->Release(); pDevice->Release(); return kCaptureStatusInitFailure; }
 
     D3D11_TEXTURE2D_DESC stagingDesc = {};
     stagingDesc.Width = desktopWidth;
@@ -116,6 +223,7 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
     }
 
     int status = kCaptureStatusSuccess;
+    double captureMs = 0.0;
 
     auto copyFrameToDib = [&]() -> int {
         DXGI_OUTDUPL_FRAME_INFO frameInfo = {};
@@ -125,6 +233,8 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
         if (hr == DXGI_ERROR_ACCESS_LOST) return 2;
         if (FAILED(hr) || !pResource) return 1;
 
+        // Time from here on is work; the wait inside AcquireNextFrame is just the desktop's pace.
+        const auto captureStart = Clock::now();
         ID3D11Texture2D* pDesktopTexture = nullptr;
         hr = pResource->QueryInterface(__uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&pDesktopTexture));
         pResource->Release();
@@ -137,15 +247,11 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
         hr = pContext->Map(pStaging, 0, D3D11_MAP_READ, 0, &mapped);
         if (FAILED(hr)) { pDuplication->ReleaseFrame(); return 1; }
 
-        const char* pSrc = static_cast<const char*>(mapped.pData) + clipCropY * mapped.RowPitch + clipCropX * 4;
-        char* pDst = static_cast<char*>(pDibBits);
-        for (int y = 0; y < captureHeight; ++y) {
-            memcpy(pDst, pSrc, dibPitch);
-            pSrc += mapped.RowPitch;
-            pDst += dibPitch;
-        }
+        const char* pSrc = static_cast<const char*>(mapped.pData) + clipCropY * mapped.RowPitch + clipCropX * converter.BytesPerPixel();
+        converter.ConvertRegion(pSrc, static_cast<int>(mapped.RowPitch), pDibBits, dibPitch, captureWidth, captureHeight);
         pContext->Unmap(pStaging, 0);
         pDuplication->ReleaseFrame();
+        captureMs = MillisecondsSince(captureStart);
         return 0;
     };
 
@@ -153,15 +259,13 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
     {
         if (options.should_pause && options.should_pause())
         {
-            RECT rc;
-            GetClientRect(window, &rc);
-            HDC hdc = GetDC(window);
-            FillRect(hdc, &rc, (HBRUSH)GetStockObject(BLACK_BRUSH));
-            ReleaseDC(window, hdc);
+            presenter->PresentBlank();
             std::this_thread::sleep_for(frameDelay);
             continue;
         }
 
+        const auto frameStart = Clock::now();
+
         if (useDynamicZoom)
         {
             const double zoom = options.get_zoom_factor();
@@ -215,7 +319,9 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
 
         if (frameResult == 0)
         {
-            if (options.overlay_callback)
+            const auto overlayStart = Clock::now();
+            const bool skipOverlay = quality.skip_alternate_overlay && (presentedFrames & 1) != 0;
+            if (options.overlay_callback && !skipOverlay)
             {
                 try
                 {
@@ -228,13 +334,41 @@ int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& runn
                 }
             }
 
-            HDC hWindowDC = GetDC(window);
-            StretchBlt(hWindowDC, 0, 0, config.display_width, config.display_height,
-                hMemoryDC, 0, 0, captureWidth, captureHeight, SRCCOPY);
-            ReleaseDC(window, hWindowDC);
+            // Overlay drawing has to land in the DIB before anything reads its pixels directly.
+            GdiFlush();
+            const double overlayMs = MillisecondsSince(overlayStart);
+
+            const auto presentStart = Clock::now();
+            const CaptureFrameContext frame{ hMemoryDC, pDibBits, dibPitch, captureWidth, captureHeight };
+            if (options.frame_callback)
+            {
+                try
+                {
+                    options.frame_callback(frame);
+                }
+                catch (...)
+                {
+                    status = kCaptureStatusFrameCallbackError;
+                    break;
+                }
+            }
+
+            presenter->Present(frame);
+            ++presentedFrames;
+
+            if (governor && governor->OnFrame(FrameStageTimings{ captureMs, overlayMs, MillisecondsSince(presentStart) }))
+            {
+                quality = governor->State();
+                presenter->SetScalingFilter(quality.cheap_scaling ? kScalingNearest : configuredFilter);
+            }
         }
 
-        std::this_thread::sleep_for(frameDelay);
+        if (options.unpaced)
+            continue;
+
+        // Pace against the frame start so work time comes out of the budget instead of adding to it.
+        const auto delay = quality.reduced_rate ? frameDelay * 2.0 : frameDelay;
+        std::this_thread::sleep_until(frameStart + std::chrono::duration_cast<Clock::duration>(delay));
     }
 
     if (hDib)
@@ -5,6 +5,8 @@
 #include <Windows.h>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <string>
 
 struct CaptureOverlayContext
 {
@@ -15,11 +17,30 @@ struct CaptureOverlayContext
 
 using OverlayCallback = std::function<void(const CaptureOverlayContext&)>;
 
+struct CaptureFrameContext
+{
+    HDC memory_dc;       // DIB selected in, overlay already applied
+    const void* pixels;  // the same DIB: top-down 8-bit BGRA
+    int pitch;
+    int capture_width;
+    int capture_height;
+};
+
+using FrameCallback = std::function<void(const CaptureFrameContext&)>;
+
+using LogCallback = std::function<void(const std::string&)>;
+
+class Presenter;
+
 struct CaptureRuntimeOptions
 {
     OverlayCallback overlay_callback;
+    FrameCallback frame_callback;
     std::function<bool()> should_pause;
     std::function<double()> get_zoom_factor;
+    std::shared_ptr<Presenter> presenter;  // defaults to a GdiPresenter on the window; required when window is null
+    LogCallback log;                       // diagnostic lines; OutputDebugStringA when empty
+    bool unpaced = false;                  // skip the frames_per_second sleep; frames then arrive at the desktop's update rate
 };
 
 enum CaptureRunStatus
@@ -27,9 +48,10 @@ enum CaptureRunStatus
     kCaptureStatusSuccess = 0,
     kCaptureStatusInitFailure = 1,
     kCaptureStatusAccessLost = 2,
-    kCaptureStatusOverlayError = 3
+    kCaptureStatusOverlayError = 3,
+    kCaptureStatusFrameCallbackError = 4
 };
 
-// Runs on the capture worker thread and invokes overlay_callback (if provided)
-// before presenting each successful frame.
+// Runs on the capture worker thread and invokes overlay_callback, then frame_callback
+// (if provided) before handing each successful frame to the presenter.
 int RunCaptureLoop(HWND window, const AppConfig& config, std::atomic<bool>& running, const CaptureRuntimeOptions& options);
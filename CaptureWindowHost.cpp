@@ -6,10 +6,15 @@
 #include "AppConfig.h"
 #include "CaptureEngine.h"
 #include "OverlayCallbacks.h"
+#include "Presenter.h"
+#include "TileStreamSink.h"
 
 #include <Windows.h>
 #include <atomic>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -18,6 +23,16 @@ namespace
 {
 std::atomic<bool> g_captureRunning{ true };
 std::atomic<int> g_captureStatus{ kCaptureStatusSuccess };
+std::thread g_captureThread;  // started and joined on the UI thread only
+
+// The capture thread presents through the window's DC, so it has to be finished before the window
+// (and with CS_OWNDC, the DC) is destroyed.
+void StopCaptureThread()
+{
+    g_captureRunning = false;
+    if (g_captureThread.joinable())
+        g_captureThread.join();
+}
 
 struct FlexState
 {
@@ -56,6 +71,34 @@ double NumpadKeyToMultiplier(WPARAM key)
     }
 }
 
+// Capture diagnostics (duplication format, quality transitions, stream stats) go to a .log file
+// next to the config, and to the debugger output.
+class FileLogSink
+{
+public:
+    explicit FileLogSink(const std::filesystem::path& path)
+        : file_(path, std::ios::app)
+    {
+    }
+
+    void Write(const std::string& line)
+    {
+        SYSTEMTIME now;
+        GetLocalTime(&now);
+        char stamp[32];
+        sprintf_s(stamp, "[%02u:%02u:%02u.%03u] ", now.wHour, now.wMinute, now.wSecond, now.wMilliseconds);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        OutputDebugStringA((stamp + line + "\n").c_str());
+        if (file_.is_open())
+            file_ << stamp << line << std::endl;
+    }
+
+private:
+    std::mutex mutex_;
+    std::ofstream file_;
+};
+
 void ShowError(const std::string& message, const char* title)
 {
     MessageBoxA(nullptr, message.c_str(), title, MB_OK | MB_ICONERROR);
@@ -72,6 +115,15 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         if (LOWORD(wParam) != WA_INACTIVE)
             SetFocus(hwnd);
         break;
+    case WM_PAINT:
+        // The capture thread repaints every frame. BeginPaint/EndPaint would touch the shared
+        // CS_OWNDC DC from this thread while the presenter draws into it, so just validate.
+        ValidateRect(hwnd, nullptr);
+        return 0;
+    case WM_CLOSE:
+        StopCaptureThread();
+        DestroyWindow(hwnd);
+        return 0;
     case WM_DESTROY:
         g_captureRunning = false;
         PostQuitMessage(0);
@@ -111,6 +163,7 @@ const char* CaptureStatusMessage(int status)
     case kCaptureStatusInitFailure: return "Capture initialization failed.";
     case kCaptureStatusAccessLost: return "Capture access was lost.";
     case kCaptureStatusOverlayError: return "Overlay callback failed.";
+    case kCaptureStatusFrameCallbackError: return "Frame callback failed.";
     default: return "Unknown capture failure.";
     }
 }
@@ -131,9 +184,10 @@ int CaptureWindowHost::Run(HINSTANCE hInstance, int nCmdShow)
     g_captureStatus = kCaptureStatusSuccess;
 
     AppConfig config{};
+    std::wstring configPath;
     try
     {
-        const std::wstring configPath = GetConfigPathFromArgsOrFail();
+        configPath = GetConfigPathFromArgsOrFail();
         config = LoadConfigFromTomlOrFail(configPath);
         ValidateConfigOrFail(config);
     }
@@ -143,7 +197,22 @@ int CaptureWindowHost::Run(HINSTANCE hInstance, int nCmdShow)
         return 1;
     }
 
+    FileLogSink logSink(std::filesystem::path(configPath).replace_extension(L".log"));
+
+    std::unique_ptr<TileStreamSink> streamSink;
+    if (config.stream_port > 0)
+    {
+        streamSink = std::make_unique<TileStreamSink>(
+            TileStreamOptions{ config.stream_port, config.stream_tile_size, config.stream_keyframe_interval });
+        if (!streamSink->Start())
+        {
+            ShowError("Failed to open the stream socket.", (error_title_ + " Startup Error").c_str());
+            return 1;
+        }
+    }
+
     WNDCLASSW wc = {};
+    wc.style = CS_OWNDC;  // GdiPresenter keeps the window DC for the lifetime of the capture loop
     wc.lpfnWndProc = WndProc;
     wc.hInstance = hInstance;
     wc.lpszClassName = window_class_name_.c_str();
@@ -182,14 +251,21 @@ int CaptureWindowHost::Run(HINSTANCE hInstance, int nCmdShow)
 
     CaptureRuntimeOptions options{};
     options.overlay_callback = GetOverlayForBehaviour(config.behaviour);
+    options.log = [&logSink](const std::string& line) { logSink.Write(line); };
     if (isFlex)
     {
         options.should_pause = [&flexState]() { return flexState.stream_paused.load(); };
         options.get_zoom_factor = [&flexState, &config]() { return config.zoom_factor * flexState.get_multiplier(); };
     }
+    if (streamSink)
+        options.frame_callback = [&streamSink](const CaptureFrameContext& frame) { streamSink->SubmitFrame(frame); };
 
-    std::thread captureThread([&]() {
-        const int status = RunCaptureLoop(hwnd, config, g_captureRunning, options);
+    g_captureThread = std::thread([&]() {
+        // The presenter acquires and releases the window DC, so it lives entirely on this thread.
+        CaptureRuntimeOptions threadOptions = options;
+        threadOptions.presenter = CreatePresenterForConfig(config.presenter, hwnd, config);
+        const int status = RunCaptureLoop(hwnd, config, g_captureRunning, threadOptions);
+        threadOptions.presenter.reset();
         g_captureStatus = status;
         if (status != kCaptureStatusSuccess)
         {
@@ -204,7 +280,13 @@ int CaptureWindowHost::Run(HINSTANCE hInstance, int nCmdShow)
         DispatchMessageW(&msg);
     }
 
-    captureThread.join();
+    StopCaptureThread();
+    if (streamSink)
+    {
+        streamSink->Stop();
+        logSink.Write("TileStreamSink: " + std::to_string(streamSink->DroppedFrames()) +
+            " frames replaced before they were sent (client slower than capture)");
+    }
 
     const int finalStatus = g_captureStatus.load();
     if (finalStatus != kCaptureStatusSuccess)
@@ -0,0 +1,358 @@
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "PixelConversion.h"
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+#include <intrin.h>
+
+namespace
+{
+constexpr float kLutScale = 4095.0f;
+constexpr std::uint32_t kOpaqueAlpha = 0xFF000000u;
+
+bool CpuSupportsF16C()
+{
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    if (!osxsave || !avx || !f16c)
+        return false;
+
+    // vcvtph2ps is VEX encoded, so the OS must also save YMM state.
+    return (_xgetbv(0) & 0x6) == 0x6;
+}
+
+float HalfToFloat(std::uint16_t h)
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+    const std::uint32_t exponent = (h >> 10) & 0x1Fu;
+    std::uint32_t mantissa = h & 0x3FFu;
+    std::uint32_t bits;
+
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            std::uint32_t shift = 0;
+            while ((mantissa & 0x400u) == 0)
+            {
+                mantissa <<= 1;
+                ++shift;
+            }
+            bits = sign | ((113u - shift) << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    }
+    else if (exponent == 0x1F)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// The scalar and SIMD curves use the same operation order so both paths land on the same LUT index.
+// Comparisons are written so NaN (and Inf/Inf) collapse to 0 on input and 1 on output, as minps/maxps do.
+template <ToneMapCurve Curve>
+int ToneMapToLutIndex(float value, float exposure)
+{
+    float x = value * exposure;
+    x = (x > 0.0f) ? x : 0.0f;
+
+    float y = x;
+    if constexpr (Curve == kToneMapReinhard)
+    {
+        y = x / (1.0f + x);
+    }
+    else if constexpr (Curve == kToneMapAces)
+    {
+        const float num = x * (2.51f * x + 0.03f);
+        const float den = x * (2.43f * x + 0.59f) + 0.14f;
+        y = num / den;
+    }
+
+    y = (y < 1.0f) ? y : 1.0f;
+    return static_cast<int>(y * kLutScale + 0.5f);
+}
+
+template <ToneMapCurve Curve>
+__m128i ToneMapToLutIndex(__m128 value, __m128 exposure)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 x = _mm_max_ps(_mm_mul_ps(value, exposure), _mm_setzero_ps());
+
+    __m128 y = x;
+    if constexpr (Curve == kToneMapReinhard)
+    {
+        y = _mm_div_ps(x, _mm_add_ps(one, x));
+    }
+    else if constexpr (Curve == kToneMapAces)
+    {
+        const __m128 num = _mm_mul_ps(x, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.51f), x), _mm_set1_ps(0.03f)));
+        const __m128 den = _mm_add_ps(_mm_mul_ps(x, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.43f), x), _mm_set1_ps(0.59f))), _mm_set1_ps(0.14f));
+        y = _mm_div_ps(num, den);
+    }
+
+    y = _mm_min_ps(y, one);
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(y, _mm_set1_ps(kLutScale)), _mm_set1_ps(0.5f)));
+}
+
+std::uint32_t Expand10To8(std::uint32_t value)
+{
+    return ((value << 8) - value + 512u) >> 10;
+}
+
+__m128i Expand10To8(__m128i value)
+{
+    return _mm_srli_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(value, 8), value), _mm_set1_epi32(512)), 10);
+}
+
+// ---- R16G16B16A16_FLOAT (scRGB, linear) ----
+
+template <ToneMapCurve Curve>
+void ConvertRowFp16Scalar(const std::uint16_t* src, std::uint32_t* dst, int width, float exposure, const std::uint8_t* lut)
+{
+    for (int x = 0; x < width; ++x, src += 4)
+    {
+        const std::uint32_t r = lut[ToneMapToLutIndex<Curve>(HalfToFloat(src[0]), exposure)];
+        const std::uint32_t g = lut[ToneMapToLutIndex<Curve>(HalfToFloat(src[1]), exposure)];
+        const std::uint32_t b = lut[ToneMapToLutIndex<Curve>(HalfToFloat(src[2]), exposure)];
+        dst[x] = b | (g << 8) | (r << 16) | kOpaqueAlpha;
+    }
+}
+
+template <ToneMapCurve Curve>
+void ConvertRowFp16F16C(const std::uint16_t* src, std::uint32_t* dst, int width, float exposure, const std::uint8_t* lut)
+{
+    const __m128 exposureVec = _mm_set1_ps(exposure);
+    alignas(16) std::uint16_t index[16];  // r0..r3 g0..g3 | b0..b3, upper half unused
+    int x = 0;
+    for (; x + 4 <= width; x += 4, src += 16)
+    {
+        // Four pixels per step: widen to float, then transpose to one register per channel so every
+        // lane of the tone map does useful work and alpha is never computed.
+        const __m128i pixels01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i pixels23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8));
+        __m128 r = _mm_cvtph_ps(pixels01);
+        __m128 g = _mm_cvtph_ps(_mm_unpackhi_epi64(pixels01, pixels01));
+        __m128 b = _mm_cvtph_ps(pixels23);
+        __m128 a = _mm_cvtph_ps(_mm_unpackhi_epi64(pixels23, pixels23));
+        _MM_TRANSPOSE4_PS(r, g, b, a);
+
+        // Indices are below 4096, so they pack losslessly into 16 bits.
+        const __m128i rg = _mm_packs_epi32(ToneMapToLutIndex<Curve>(r, exposureVec), ToneMapToLutIndex<Curve>(g, exposureVec));
+        const __m128i bb = _mm_packs_epi32(ToneMapToLutIndex<Curve>(b, exposureVec), _mm_setzero_si128());
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), rg);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index + 8), bb);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            dst[x + i] = static_cast<std::uint32_t>(lut[index[8 + i]]) |
+                (static_cast<std::uint32_t>(lut[index[4 + i]]) << 8) |
+                (static_cast<std::uint32_t>(lut[index[i]]) << 16) | kOpaqueAlpha;
+        }
+    }
+    ConvertRowFp16Scalar<Curve>(src, dst + x, width - x, exposure, lut);
+}
+
+template <ToneMapCurve Curve>
+void ConvertRegionFp16(const char* src, int srcPitch, char* dst, int dstPitch, int width, int height,
+    float exposure, const std::uint8_t* lut, bool useF16C)
+{
+    for (int y = 0; y < height; ++y, src += srcPitch, dst += dstPitch)
+    {
+        const auto* srcRow = reinterpret_cast<const std::uint16_t*>(src);
+        auto* dstRow = reinterpret_cast<std::uint32_t*>(dst);
+        if (useF16C)
+            ConvertRowFp16F16C<Curve>(srcRow, dstRow, width, exposure, lut);
+        else
+            ConvertRowFp16Scalar<Curve>(srcRow, dstRow, width, exposure, lut);
+    }
+}
+
+// ---- R10G10B10A2_UNORM (display referred, no tone map) ----
+
+void ConvertRowR10G10B10A2Scalar(const std::uint32_t* src, std::uint32_t* dst, int width)
+{
+    for (int x = 0; x < width; ++x)
+    {
+        const std::uint32_t v = src[x];
+        const std::uint32_t r = Expand10To8(v & 0x3FFu);
+        const std::uint32_t g = Expand10To8((v >> 10) & 0x3FFu);
+        const std::uint32_t b = Expand10To8((v >> 20) & 0x3FFu);
+        dst[x] = b | (g << 8) | (r << 16) | kOpaqueAlpha;
+    }
+}
+
+void ConvertRowR10G10B10A2Sse2(const std::uint32_t* src, std::uint32_t* dst, int width)
+{
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(kOpaqueAlpha));
+    int x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+        const __m128i r = Expand10To8(_mm_and_si128(v, mask));
+        const __m128i g = Expand10To8(_mm_and_si128(_mm_srli_epi32(v, 10), mask));
+        const __m128i b = Expand10To8(_mm_and_si128(_mm_srli_epi32(v, 20), mask));
+        const __m128i out = _mm_or_si128(_mm_or_si128(b, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(r, 16), alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), out);
+    }
+    ConvertRowR10G10B10A2Scalar(src + x, dst + x, width - x);
+}
+
+// ---- R8G8B8A8_UNORM (red/blue swap) ----
+
+void ConvertRowR8G8B8A8Scalar(const std::uint32_t* src, std::uint32_t* dst, int width)
+{
+    for (int x = 0; x < width; ++x)
+    {
+        const std::uint32_t v = src[x];
+        dst[x] = (v & 0x0000FF00u) | ((v >> 16) & 0xFFu) | ((v & 0xFFu) << 16) | kOpaqueAlpha;
+    }
+}
+
+void ConvertRowR8G8B8A8Sse2(const std::uint32_t* src, std::uint32_t* dst, int width)
+{
+    const __m128i greenMask = _mm_set1_epi32(0x0000FF00);
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(kOpaqueAlpha));
+    int x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+        const __m128i g = _mm_and_si128(v, greenMask);
+        const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 16), byteMask);
+        const __m128i r = _mm_slli_epi32(_mm_and_si128(v, byteMask), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_or_si128(_mm_or_si128(g, b), _mm_or_si128(r, alpha)));
+    }
+    ConvertRowR8G8B8A8Scalar(src + x, dst + x, width - x);
+}
+
+template <typename RowFn>
+void ConvertRegion32(const char* src, int srcPitch, char* dst, int dstPitch, int width, int height, RowFn rowFn)
+{
+    for (int y = 0; y < height; ++y, src += srcPitch, dst += dstPitch)
+        rowFn(reinterpret_cast<const std::uint32_t*>(src), reinterpret_cast<std::uint32_t*>(dst), width);
+}
+
+void CopyRegionBgra8(const char* src, int srcPitch, char* dst, int dstPitch, int width, int height)
+{
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = 0; y < height; ++y, src += srcPitch, dst += dstPitch)
+        std::memcpy(dst, src, rowBytes);
+}
+}  // namespace
+
+ToneMapCurve ToneMapCurveFromName(const std::string& name)
+{
+    if (name == "clamp")
+        return kToneMapClamp;
+    if (name == "aces")
+        return kToneMapAces;
+    return kToneMapReinhard;
+}
+
+int GetSourceBytesPerPixel(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+        return 4;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+PixelConverter::PixelConverter(DXGI_FORMAT format, const ToneMapSettings& tone_map)
+    : format_(format)
+    , tone_map_(tone_map)
+    , bytes_per_pixel_(GetSourceBytesPerPixel(format))
+    , use_f16c_(format == DXGI_FORMAT_R16G16B16A16_FLOAT && CpuSupportsF16C())
+    , srgb_encode_lut_{}
+{
+    if (format_ != DXGI_FORMAT_R16G16B16A16_FLOAT)
+        return;
+
+    for (int i = 0; i < kEncodeLutSize; ++i)
+    {
+        const double linear = static_cast<double>(i) / (kEncodeLutSize - 1);
+        const double encoded = (linear <= 0.0031308) ? 12.92 * linear : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+        const double scaled = encoded * 255.0 + 0.5;
+        srgb_encode_lut_[i] = static_cast<std::uint8_t>(scaled > 255.0 ? 255.0 : scaled);
+    }
+}
+
+void PixelConverter::ConvertRegion(const void* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const
+{
+    Convert(src, src_pitch, dst, dst_pitch, width, height, true);
+}
+
+void PixelConverter::ConvertRegionScalar(const void* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const
+{
+    Convert(src, src_pitch, dst, dst_pitch, width, height, false);
+}
+
+void PixelConverter::Convert(const void* src, int src_pitch, void* dst, int dst_pitch, int width, int height, bool allow_simd) const
+{
+    const char* pSrc = static_cast<const char*>(src);
+    char* pDst = static_cast<char*>(dst);
+
+    switch (format_)
+    {
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        CopyRegionBgra8(pSrc, src_pitch, pDst, dst_pitch, width, height);
+        break;
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        ConvertRegion32(pSrc, src_pitch, pDst, dst_pitch, width, height,
+            allow_simd ? ConvertRowR8G8B8A8Sse2 : ConvertRowR8G8B8A8Scalar);
+        break;
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+        ConvertRegion32(pSrc, src_pitch, pDst, dst_pitch, width, height,
+            allow_simd ? ConvertRowR10G10B10A2Sse2 : ConvertRowR10G10B10A2Scalar);
+        break;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    {
+        const std::uint8_t* lut = srgb_encode_lut_.data();
+        const bool useF16C = allow_simd && use_f16c_;
+        switch (tone_map_.curve)
+        {
+        case kToneMapClamp:
+            ConvertRegionFp16<kToneMapClamp>(pSrc, src_pitch, pDst, dst_pitch, width, height, tone_map_.exposure, lut, useF16C);
+            break;
+        case kToneMapAces:
+            ConvertRegionFp16<kToneMapAces>(pSrc, src_pitch, pDst, dst_pitch, width, height, tone_map_.exposure, lut, useF16C);
+            break;
+        default:
+            ConvertRegionFp16<kToneMapReinhard>(pSrc, src_pitch, pDst, dst_pitch, width, height, tone_map_.exposure, lut, useF16C);
+            break;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
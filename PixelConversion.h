@@ -0,0 +1,52 @@
+#pragma once
+
+#include <dxgiformat.h>
+#include <array>
+#include <cstdint>
+#include <string>
+
+enum ToneMapCurve
+{
+    kToneMapClamp = 0,
+    kToneMapReinhard = 1,
+    kToneMapAces = 2
+};
+
+struct ToneMapSettings
+{
+    ToneMapCurve curve;
+    float exposure;  // multiplier applied to linear scRGB before the curve
+};
+
+// Maps a validated tone_map config string to its curve; empty or unknown selects reinhard.
+ToneMapCurve ToneMapCurveFromName(const std::string& name);
+
+// Returns the bytes per pixel of a desktop format that can be converted to 8-bit BGRA, or 0 if unsupported.
+int GetSourceBytesPerPixel(DXGI_FORMAT format);
+
+// Converts desktop pixels of one format into 8-bit BGRA. The conversion is fused into the crop copy,
+// so each source byte is read once. SIMD paths are picked at construction; ConvertRegionScalar is the
+// reference they must match.
+class PixelConverter
+{
+public:
+    PixelConverter(DXGI_FORMAT format, const ToneMapSettings& tone_map);
+
+    bool IsSupported() const { return bytes_per_pixel_ != 0; }
+    int BytesPerPixel() const { return bytes_per_pixel_; }
+
+    // src points at the top-left pixel of the region; pitches are in bytes.
+    void ConvertRegion(const void* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const;
+    void ConvertRegionScalar(const void* src, int src_pitch, void* dst, int dst_pitch, int width, int height) const;
+
+private:
+    void Convert(const void* src, int src_pitch, void* dst, int dst_pitch, int width, int height, bool allow_simd) const;
+
+    static constexpr int kEncodeLutSize = 4096;
+
+    DXGI_FORMAT format_;
+    ToneMapSettings tone_map_;
+    int bytes_per_pixel_;
+    bool use_f16c_;
+    std::array<std::uint8_t, kEncodeLutSize> srgb_encode_lut_;  // tone-mapped linear [0,1] -> sRGB byte
+};
@@ -0,0 +1,120 @@
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "Presenter.h"
+
+#include <Windows.h>
+#include <cstring>
+#include <utility>
+
+GdiPresenter::GdiPresenter(HWND window, int display_width, int display_height)
+    : window_(window)
+    , window_dc_(GetDC(window))
+    , black_brush_(static_cast<HBRUSH>(GetStockObject(BLACK_BRUSH)))
+    , display_width_(display_width)
+    , display_height_(display_height)
+{
+    if (window_dc_)
+        SetStretchBltMode(window_dc_, COLORONCOLOR);
+}
+
+GdiPresenter::~GdiPresenter()
+{
+    if (window_dc_)
+        ReleaseDC(window_, window_dc_);
+}
+
+void GdiPresenter::Present(const CaptureFrameContext& frame)
+{
+    StretchBlt(window_dc_, 0, 0, display_width_, display_height_,
+        frame.memory_dc, 0, 0, frame.capture_width, frame.capture_height, SRCCOPY);
+}
+
+void GdiPresenter::PresentBlank()
+{
+    // The client area changes when the window is maximized, so it is not cached.
+    RECT rc;
+    GetClientRect(window_, &rc);
+    FillRect(window_dc_, &rc, black_brush_);
+}
+
+void GdiPresenter::SetScalingFilter(ScalingFilter filter)
+{
+    SetStretchBltMode(window_dc_, filter == kScalingHalftone ? HALFTONE : COLORONCOLOR);
+    // HALFTONE requires the brush origin to be reset after switching modes.
+    SetBrushOrgEx(window_dc_, 0, 0, nullptr);
+}
+
+MemoryPresenter::MemoryPresenter(int display_width, int display_height, std::size_t max_frames)
+    : display_width_(display_width)
+    , display_height_(display_height)
+    , max_frames_(max_frames > 0 ? max_frames : 1)
+{
+}
+
+void MemoryPresenter::Present(const CaptureFrameContext& frame)
+{
+    if (frame.capture_width != source_x_width_)
+    {
+        source_x_.resize(display_width_);
+        for (int x = 0; x < display_width_; ++x)
+            source_x_[x] = static_cast<int>(static_cast<long long>(x) * frame.capture_width / display_width_);
+        source_x_width_ = frame.capture_width;
+    }
+
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    PresentedFrame& slot = NextSlot(false);
+    auto* dst = reinterpret_cast<std::uint32_t*>(slot.pixels.data());
+    for (int y = 0; y < display_height_; ++y, dst += display_width_)
+    {
+        const int sourceY = static_cast<int>(static_cast<long long>(y) * frame.capture_height / display_height_);
+        const auto* src = reinterpret_cast<const std::uint32_t*>(static_cast<const std::uint8_t*>(frame.pixels) + static_cast<std::size_t>(sourceY) * frame.pitch);
+        for (int x = 0; x < display_width_; ++x)
+            dst[x] = src[source_x_[x]];
+    }
+}
+
+void MemoryPresenter::PresentBlank()
+{
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    PresentedFrame& slot = NextSlot(true);
+    std::memset(slot.pixels.data(), 0, slot.pixels.size());
+}
+
+std::vector<PresentedFrame> MemoryPresenter::TakeFrames()
+{
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    return std::exchange(frames_, {});
+}
+
+PresentedFrame& MemoryPresenter::NextSlot(bool blank)
+{
+    // Caller holds frames_mutex_. Oldest frames are dropped once max_frames_ is reached.
+    PresentedFrame slot{};
+    if (frames_.size() >= max_frames_)
+    {
+        slot = std::move(frames_.front());
+        frames_.erase(frames_.begin());
+    }
+    slot.width = display_width_;
+    slot.height = display_height_;
+    slot.blank = blank;
+    slot.pixels.resize(static_cast<std::size_t>(display_width_) * display_height_ * 4);
+    frames_.push_back(std::move(slot));
+    return frames_.back();
+}
+
+ScalingFilter ScalingFilterFromName(const std::string& name)
+{
+    if (name == "halftone")
+        return kScalingHalftone;
+    return kScalingNearest;
+}
+
+std::shared_ptr<Presenter> CreatePresenterForConfig(const std::string& name, HWND window, const AppConfig& config)
+{
+    if (name == "null")
+        return std::make_shared<NullPresenter>();
+    return std::make_shared<GdiPresenter>(window, config.display_width, config.display_height);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "AppConfig.h"
+#include "CaptureEngine.h"
+
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum ScalingFilter
+{
+    kScalingNearest = 0,   // COLORONCOLOR: drops pixels, cheapest
+    kScalingHalftone = 1   // HALFTONE: averages pixels, noticeably slower
+};
+
+// Final stage of the capture loop. A presenter is created once, owns whatever it needs to show
+// frames for its whole lifetime, and is only called from the capture thread.
+class Presenter
+{
+public:
+    virtual ~Presenter() = default;
+
+    // Shows a captured frame, scaled to the display size.
+    virtual void Present(const CaptureFrameContext& frame) = 0;
+
+    // Shows an empty (black) output while the stream is paused.
+    virtual void PresentBlank() = 0;
+
+    // Chooses how frames are scaled to the display size. Presenters that do not scale ignore it.
+    virtual void SetScalingFilter(ScalingFilter) {}
+};
+
+// StretchBlt into the window through a DC held for the presenter's lifetime.
+// The window class should use CS_OWNDC so the cached DC stays private to the window. Create and
+// destroy it on the presenting thread, and destroy it before the window.
+class GdiPresenter : public Presenter
+{
+public:
+    GdiPresenter(HWND window, int display_width, int display_height);
+    ~GdiPresenter() override;
+
+    GdiPresenter(const GdiPresenter&) = delete;
+    GdiPresenter& operator=(const GdiPresenter&) = delete;
+
+    void Present(const CaptureFrameContext& frame) override;
+    void PresentBlank() override;
+    void SetScalingFilter(ScalingFilter filter) override;
+
+private:
+    HWND window_;
+    HDC window_dc_;
+    HBRUSH black_brush_;
+    int display_width_;
+    int display_height_;
+};
+
+// Discards every frame. Used to measure the loop without present cost.
+class NullPresenter : public Presenter
+{
+public:
+    void Present(const CaptureFrameContext&) override { ++presented_frames_; }
+    void PresentBlank() override { ++blank_frames_; }
+
+    std::uint64_t PresentedFrames() const { return presented_frames_.load(); }
+    std::uint64_t BlankFrames() const { return blank_frames_.load(); }
+
+private:
+    std::atomic<std::uint64_t> presented_frames_{ 0 };
+    std::atomic<std::uint64_t> blank_frames_{ 0 };
+};
+
+struct PresentedFrame
+{
+    int width;
+    int height;
+    bool blank;
+    std::vector<std::uint8_t> pixels;  // top-down 8-bit BGRA, width * 4 bytes per row
+};
+
+// Keeps the most recent max_frames output frames in memory, scaled nearest-neighbour to the display
+// size like GdiPresenter's COLORONCOLOR StretchBlt. Frames can be collected from any thread.
+class MemoryPresenter : public Presenter
+{
+public:
+    MemoryPresenter(int display_width, int display_height, std::size_t max_frames);
+
+    void Present(const CaptureFrameContext& frame) override;
+    void PresentBlank() override;
+
+    std::vector<PresentedFrame> TakeFrames();
+
+private:
+    PresentedFrame& NextSlot(bool blank);
+
+    int display_width_;
+    int display_height_;
+    std::size_t max_frames_;
+    std::mutex frames_mutex_;
+    std::vector<PresentedFrame> frames_;
+    std::vector<int> source_x_;  // output column -> source column, rebuilt when the capture width changes
+    int source_x_width_ = 0;
+};
+
+// Maps a validated scaling_filter config string ("nearest", "halftone") to its filter; empty selects nearest.
+ScalingFilter ScalingFilterFromName(const std::string& name);
+
+// Returns the presenter for the given config name ("gdi", "null"); empty selects gdi.
+std::shared_ptr<Presenter> CreatePresenterForConfig(const std::string& name, HWND window, const AppConfig& config);
@@ -0,0 +1,111 @@
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "QualityGovernor.h"
+
+#include <Windows.h>
+#include <cstdio>
+#include <utility>
+
+QualityGovernor::QualityGovernor(QualityGovernorSettings settings, LogCallback log)
+    : settings_(std::move(settings))
+    , log_(std::move(log))
+{
+    if (settings_.window_frames < 1)
+        settings_.window_frames = 1;
+    if (settings_.calm_windows_to_step_up < 1)
+        settings_.calm_windows_to_step_up = 1;
+}
+
+bool QualityGovernor::OnFrame(const FrameStageTimings& timings)
+{
+    window_sum_.capture_ms += timings.capture_ms;
+    window_sum_.overlay_ms += timings.overlay_ms;
+    window_sum_.present_ms += timings.present_ms;
+    if (++window_count_ < settings_.window_frames)
+        return false;
+
+    const double averageWorkMs = (window_sum_.capture_ms + window_sum_.overlay_ms + window_sum_.present_ms) / window_count_;
+    const int previousLevel = level_;
+
+    if (averageWorkMs > settings_.frame_budget_ms * settings_.step_down_ratio)
+    {
+        calm_windows_ = 0;
+        if (level_ < MaxLevel())
+            Transition(level_ + 1, averageWorkMs);
+    }
+    else if (averageWorkMs < settings_.frame_budget_ms * settings_.step_up_ratio)
+    {
+        if (level_ > 0 && ++calm_windows_ >= settings_.calm_windows_to_step_up)
+        {
+            calm_windows_ = 0;
+            Transition(level_ - 1, averageWorkMs);
+        }
+    }
+    else
+    {
+        calm_windows_ = 0;
+    }
+
+    window_sum_ = FrameStageTimings{};
+    window_count_ = 0;
+    return level_ != previousLevel;
+}
+
+QualityState QualityGovernor::State() const
+{
+    QualityState state{};
+    for (int i = 0; i < level_; ++i)
+    {
+        switch (settings_.levels[i])
+        {
+        case kDegradeCheapScaling: state.cheap_scaling = true; break;
+        case kDegradeSkipOverlay: state.skip_alternate_overlay = true; break;
+        case kDegradeReduceRate: state.reduced_rate = true; break;
+        }
+    }
+    return state;
+}
+
+void QualityGovernor::Transition(int new_level, double average_work_ms)
+{
+    // Name the step being entered (down) or left (up).
+    const bool down = new_level > level_;
+    const DegradationStep step = settings_.levels[down ? new_level - 1 : level_ - 1];
+    const double count = static_cast<double>(window_count_);
+
+    char line[256];
+    std::snprintf(line, sizeof(line),
+        "QualityGovernor: level %d -> %d (%s %s), avg work %.2f ms of %.2f ms budget "
+        "[capture %.2f, overlay %.2f, present %.2f]",
+        level_, new_level, down ? "enable" : "disable", DegradationStepName(step),
+        average_work_ms, settings_.frame_budget_ms,
+        window_sum_.capture_ms / count, window_sum_.overlay_ms / count, window_sum_.present_ms / count);
+
+    level_ = new_level;
+    if (log_)
+        log_(line);
+    else
+        OutputDebugStringA((std::string(line) + "\n").c_str());
+}
+
+DegradationStep DegradationStepFromName(const std::string& name)
+{
+    if (name == "skip_overlay")
+        return kDegradeSkipOverlay;
+    if (name == "reduce_rate")
+        return kDegradeReduceRate;
+    return kDegradeCheapScaling;
+}
+
+const char* DegradationStepName(DegradationStep step)
+{
+    switch (step)
+    {
+    case kDegradeCheapScaling: return "cheap_scaling";
+    case kDegradeSkipOverlay: return "skip_overlay";
+    case kDegradeReduceRate: return "reduce_rate";
+    default: return "unknown";
+    }
+}
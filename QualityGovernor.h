@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+enum DegradationStep
+{
+    kDegradeCheapScaling = 0,  // nearest-neighbour instead of the configured scaling filter
+    kDegradeSkipOverlay = 1,   // draw the overlay on alternate frames only
+    kDegradeReduceRate = 2     // capture at half of frames_per_second
+};
+
+struct FrameStageTimings
+{
+    double capture_ms;  // readback + format conversion, excluding the wait for a new desktop frame
+    double overlay_ms;
+    double present_ms;  // frame callback + presenter
+};
+
+struct QualityGovernorSettings
+{
+    double frame_budget_ms;
+    std::vector<DegradationStep> levels;  // applied cumulatively: level N enables levels[0..N-1]
+    int window_frames = 30;               // frames averaged per decision
+    double step_down_ratio = 0.9;         // average work above this share of the budget steps down
+    double step_up_ratio = 0.6;           // average work below this share counts as a calm window
+    int calm_windows_to_step_up = 3;      // consecutive calm windows needed to step back up
+};
+
+struct QualityState
+{
+    bool cheap_scaling;
+    bool skip_alternate_overlay;
+    bool reduced_rate;
+};
+
+// Watches per-stage frame timings against the frame budget and moves between degradation levels.
+// Pure policy with no clock of its own, so it can be driven by measured or synthetic timings.
+class QualityGovernor
+{
+public:
+    using LogCallback = std::function<void(const std::string&)>;
+
+    // log receives one line per level transition; if empty, lines go to OutputDebugStringA.
+    QualityGovernor(QualityGovernorSettings settings, LogCallback log);
+
+    // Records one frame. Returns true if the level changed as a result.
+    bool OnFrame(const FrameStageTimings& timings);
+
+    int Level() const { return level_; }
+    int MaxLevel() const { return static_cast<int>(settings_.levels.size()); }
+    QualityState State() const;
+
+private:
+    void Transition(int new_level, double average_work_ms);
+
+    QualityGovernorSettings settings_;
+    LogCallback log_;
+    int level_ = 0;
+    int window_count_ = 0;
+    FrameStageTimings window_sum_{};
+    int calm_windows_ = 0;
+};
+
+// Maps a validated governor_levels config entry to its step.
+DegradationStep DegradationStepFromName(const std::string& name);
+const char* DegradationStepName(DegradationStep step);
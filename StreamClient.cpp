@@ -0,0 +1,161 @@
+// StreamClient.cpp : reference client for the tile stream. Reassembles frames and prints
+// throughput and capture-to-decode latency once per second.
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "StreamProtocol.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace
+{
+struct StreamStats
+{
+    std::uint64_t frames = 0;
+    std::uint64_t keyframes = 0;
+    std::uint64_t tiles = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t latency_sum_us = 0;
+    std::uint64_t latency_max_us = 0;
+};
+
+void PrintStats(const StreamStats& stats, std::uint64_t elapsed_us)
+{
+    const double seconds = static_cast<double>(elapsed_us) / 1e6;
+    const double frames = stats.frames ? static_cast<double>(stats.frames) : 1.0;
+    std::printf("fps %6.1f | %7.2f MB/s | tiles/frame %6.1f | keyframes %llu | dropped %llu | latency avg %6.2f ms max %6.2f ms\n",
+        static_cast<double>(stats.frames) / seconds,
+        static_cast<double>(stats.bytes) / seconds / (1024.0 * 1024.0),
+        static_cast<double>(stats.tiles) / frames,
+        static_cast<unsigned long long>(stats.keyframes),
+        static_cast<unsigned long long>(stats.dropped),
+        static_cast<double>(stats.latency_sum_us) / frames / 1000.0,
+        static_cast<double>(stats.latency_max_us) / 1000.0);
+    std::fflush(stdout);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    int port = 0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--port") == 0)
+            port = std::atoi(argv[i + 1]);
+    }
+    if (port <= 0 || port > 65535)
+    {
+        std::fprintf(stderr, "Usage: FastMagStream.StreamClient --port <stream_port>\n");
+        return 1;
+    }
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        std::fprintf(stderr, "WSAStartup failed.\n");
+        return 1;
+    }
+
+    SOCKET socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<u_short>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (socket == INVALID_SOCKET || connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR)
+    {
+        std::fprintf(stderr, "Unable to connect to 127.0.0.1:%d.\n", port);
+        if (socket != INVALID_SOCKET)
+            closesocket(socket);
+        WSACleanup();
+        return 1;
+    }
+
+    std::vector<std::uint8_t> payload;
+    std::vector<std::uint8_t> frame;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    bool haveKeyframe = false;
+    bool haveIndex = false;
+    std::uint32_t lastIndex = 0;
+
+    StreamStats stats;
+    std::uint64_t windowStart = StreamClockMicroseconds();
+    int exitCode = 0;
+
+    for (;;)
+    {
+        StreamFrameHeader header;
+        if (!RecvAll(socket, reinterpret_cast<std::uint8_t*>(&header), sizeof(header)))
+            break;
+        if (header.magic != kStreamMagic || header.version != kStreamVersion || header.tile_size == 0)
+        {
+            std::fprintf(stderr, "Unexpected stream header.\n");
+            exitCode = 1;
+            break;
+        }
+
+        payload.resize(header.payload_bytes);
+        if (!RecvAll(socket, payload.data(), payload.size()))
+            break;
+
+        const bool keyframe = (header.flags & kStreamFlagKeyframe) != 0;
+        if (keyframe)
+        {
+            width = header.width;
+            height = header.height;
+            frame.assign(static_cast<std::size_t>(width) * height * 4, 0);
+            haveKeyframe = true;
+            ++stats.keyframes;
+        }
+        else if (!haveKeyframe || header.width != width || header.height != height)
+        {
+            std::fprintf(stderr, "Delta frame without a matching keyframe.\n");
+            exitCode = 1;
+            break;
+        }
+
+        if (!DecodeFrame(header, payload, frame))
+        {
+            std::fprintf(stderr, "Malformed tile data in frame %u.\n", header.frame_index);
+            exitCode = 1;
+            break;
+        }
+        const std::uint64_t decodedAt = StreamClockMicroseconds();
+
+        if (haveIndex && header.frame_index > lastIndex + 1)
+            stats.dropped += header.frame_index - lastIndex - 1;
+        lastIndex = header.frame_index;
+        haveIndex = true;
+
+        const std::uint64_t latency = decodedAt - header.capture_time_us;
+        ++stats.frames;
+        stats.tiles += header.tile_count;
+        stats.bytes += sizeof(header) + payload.size();
+        stats.latency_sum_us += latency;
+        if (latency > stats.latency_max_us)
+            stats.latency_max_us = latency;
+
+        if (decodedAt - windowStart >= 1000000)
+        {
+            PrintStats(stats, decodedAt - windowStart);
+            stats = StreamStats{};
+            windowStart = decodedAt;
+        }
+    }
+
+    closesocket(socket);
+    WSACleanup();
+    return exitCode;
+}
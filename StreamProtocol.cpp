@@ -0,0 +1,180 @@
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+#include "StreamProtocol.h"
+
+#include <chrono>
+#include <cstring>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace
+{
+constexpr std::size_t kRleRunBytes = 1 + sizeof(std::uint32_t);
+constexpr int kRleMaxRun = 256;
+
+std::uint32_t LoadPixel(const std::uint8_t* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void AppendRun(std::vector<std::uint8_t>& out, int length, std::uint32_t pixel)
+{
+    const std::size_t offset = out.size();
+    out.resize(offset + kRleRunBytes);
+    out[offset] = static_cast<std::uint8_t>(length - 1);
+    std::memcpy(out.data() + offset + 1, &pixel, sizeof(pixel));
+}
+}  // namespace
+
+std::uint64_t StreamClockMicroseconds()
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+StreamTileEncoding EncodeTile(const std::uint8_t* pixels, int pitch, int tile_width, int tile_height, std::vector<std::uint8_t>& out)
+{
+    const std::size_t start = out.size();
+    const std::size_t rawBytes = static_cast<std::size_t>(tile_width) * tile_height * 4;
+
+    // Try RLE first and bail out as soon as it stops paying for itself.
+    bool rleWins = true;
+    int runLength = 0;
+    std::uint32_t runPixel = 0;
+    for (int y = 0; y < tile_height && rleWins; ++y)
+    {
+        const std::uint8_t* row = pixels + static_cast<std::size_t>(y) * pitch;
+        for (int x = 0; x < tile_width; ++x)
+        {
+            const std::uint32_t pixel = LoadPixel(row + x * 4);
+            if (runLength > 0 && pixel == runPixel && runLength < kRleMaxRun)
+            {
+                ++runLength;
+                continue;
+            }
+            if (runLength > 0)
+                AppendRun(out, runLength, runPixel);
+            runPixel = pixel;
+            runLength = 1;
+
+            if (out.size() - start + kRleRunBytes >= rawBytes)
+            {
+                rleWins = false;
+                break;
+            }
+        }
+    }
+
+    if (rleWins)
+    {
+        AppendRun(out, runLength, runPixel);
+        return kTileEncodingRle;
+    }
+
+    out.resize(start + rawBytes);
+    std::uint8_t* dst = out.data() + start;
+    const std::size_t rowBytes = static_cast<std::size_t>(tile_width) * 4;
+    for (int y = 0; y < tile_height; ++y, dst += rowBytes)
+        std::memcpy(dst, pixels + static_cast<std::size_t>(y) * pitch, rowBytes);
+    return kTileEncodingRaw;
+}
+
+bool DecodeTile(StreamTileEncoding encoding, const std::uint8_t* data, std::size_t data_bytes,
+    std::uint8_t* pixels, int pitch, int tile_width, int tile_height)
+{
+    const std::size_t rowBytes = static_cast<std::size_t>(tile_width) * 4;
+
+    if (encoding == kTileEncodingRaw)
+    {
+        if (data_bytes != rowBytes * tile_height)
+            return false;
+        for (int y = 0; y < tile_height; ++y, data += rowBytes)
+            std::memcpy(pixels + static_cast<std::size_t>(y) * pitch, data, rowBytes);
+        return true;
+    }
+
+    if (encoding != kTileEncodingRle || data_bytes % kRleRunBytes != 0)
+        return false;
+
+    const std::uint8_t* end = data + data_bytes;
+    int x = 0;
+    int y = 0;
+    while (data < end)
+    {
+        int length = data[0] + 1;
+        const std::uint32_t pixel = LoadPixel(data + 1);
+        data += kRleRunBytes;
+
+        while (length > 0)
+        {
+            if (y >= tile_height)
+                return false;
+            std::uint8_t* row = pixels + static_cast<std::size_t>(y) * pitch;
+            const int span = (length < tile_width - x) ? length : tile_width - x;
+            for (int i = 0; i < span; ++i)
+                std::memcpy(row + (x + i) * 4, &pixel, sizeof(pixel));
+            x += span;
+            length -= span;
+            if (x == tile_width)
+            {
+                x = 0;
+                ++y;
+            }
+        }
+    }
+
+    return y == tile_height && x == 0;
+}
+
+bool DecodeFrame(const StreamFrameHeader& header, const std::vector<std::uint8_t>& payload, std::vector<std::uint8_t>& frame)
+{
+    const int width = static_cast<int>(header.width);
+    const int height = static_cast<int>(header.height);
+    const int tileSize = header.tile_size;
+    const int pitch = width * 4;
+    if (tileSize == 0 || frame.size() != static_cast<std::size_t>(pitch) * height)
+        return false;
+
+    std::size_t offset = 0;
+    for (std::uint32_t i = 0; i < header.tile_count; ++i)
+    {
+        StreamTileHeader tile;
+        if (payload.size() - offset < sizeof(tile))
+            return false;
+        std::memcpy(&tile, payload.data() + offset, sizeof(tile));
+        offset += sizeof(tile);
+        if (payload.size() - offset < tile.data_bytes)
+            return false;
+
+        const int x0 = tile.tile_x * tileSize;
+        const int y0 = tile.tile_y * tileSize;
+        if (x0 >= width || y0 >= height)
+            return false;
+        const int tileWidth = (tileSize < width - x0) ? tileSize : width - x0;
+        const int tileHeight = (tileSize < height - y0) ? tileSize : height - y0;
+
+        std::uint8_t* dst = frame.data() + static_cast<std::size_t>(y0) * pitch + static_cast<std::size_t>(x0) * 4;
+        if (!DecodeTile(static_cast<StreamTileEncoding>(tile.encoding), payload.data() + offset, tile.data_bytes, dst, pitch, tileWidth, tileHeight))
+            return false;
+        offset += tile.data_bytes;
+    }
+    return offset == payload.size();
+}
+
+bool RecvAll(SOCKET socket, std::uint8_t* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const int chunk = static_cast<int>(size < (1u << 20) ? size : (1u << 20));
+        const int received = recv(socket, reinterpret_cast<char*>(data), chunk, 0);
+        if (received == SOCKET_ERROR || received == 0)
+            return false;
+        data += received;
+        size -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// winsock2.h has to precede Windows.h, so include this header before anything that pulls Windows.h in.
+#include <winsock2.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wire format shared by TileStreamSink and the reference client. All fields are little-endian.
+// Each frame is a StreamFrameHeader followed by tile_count records of StreamTileHeader + tile data.
+// Keyframes carry every tile; delta frames carry only tiles that changed since the previous frame sent.
+
+constexpr std::uint32_t kStreamMagic = 0x46534D46;  // "FMSF"
+constexpr std::uint16_t kStreamVersion = 1;
+constexpr std::uint16_t kStreamFlagKeyframe = 0x1;
+
+enum StreamTileEncoding : std::uint8_t
+{
+    kTileEncodingRaw = 0,  // tile_width * tile_height BGRA pixels, row-major
+    kTileEncodingRle = 1   // runs of [uint8 length - 1][uint32 BGRA pixel], row-major across the tile
+};
+
+#pragma pack(push, 1)
+struct StreamFrameHeader
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t flags;
+    std::uint32_t frame_index;      // capture sequence number; gaps are frames dropped by the sender
+    std::uint64_t capture_time_us;  // StreamClockMicroseconds() when the frame was submitted
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint16_t tile_size;
+    std::uint16_t reserved;
+    std::uint32_t tile_count;
+    std::uint32_t payload_bytes;    // bytes of tile records following this header
+};
+
+struct StreamTileHeader
+{
+    std::uint16_t tile_x;  // in tiles
+    std::uint16_t tile_y;
+    std::uint8_t encoding;
+    std::uint32_t data_bytes;
+};
+#pragma pack(pop)
+
+// Monotonic clock in microseconds, comparable between processes on the same machine.
+std::uint64_t StreamClockMicroseconds();
+
+// Appends a tile_width x tile_height BGRA tile to out, RLE-encoded when that is smaller than raw.
+StreamTileEncoding EncodeTile(const std::uint8_t* pixels, int pitch, int tile_width, int tile_height, std::vector<std::uint8_t>& out);
+
+// Writes a decoded tile into the frame at pixels (already offset to the tile origin). Returns false on malformed data.
+bool DecodeTile(StreamTileEncoding encoding, const std::uint8_t* data, std::size_t data_bytes,
+    std::uint8_t* pixels, int pitch, int tile_width, int tile_height);
+
+// Applies every tile record in payload to frame, a header.width x header.height BGRA buffer holding the
+// previous frame (or cleared, for a keyframe). Returns false if any record is truncated, out of bounds
+// or malformed, or if the payload has trailing bytes.
+bool DecodeFrame(const StreamFrameHeader& header, const std::vector<std::uint8_t>& payload, std::vector<std::uint8_t>& frame);
+
+// Receives exactly size bytes. Returns false if the connection closes or fails first.
+bool RecvAll(SOCKET socket, std::uint8_t* data, std::size_t size);
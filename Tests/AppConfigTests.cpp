@@ -0,0 +1,51 @@
+// AppConfigTests.cpp : ValidateConfigOrFail rules that depend on more than one key.
+
+#include "TestSupport.h"
+
+#include "AppConfig.h"
+
+#include <stdexcept>
+
+namespace
+{
+AppConfig ValidConfig()
+{
+    AppConfig config{};
+    config.display_width = 640;
+    config.display_height = 360;
+    config.record_width = 640;
+    config.record_height = 360;
+    config.zoom_factor = 2.0;
+    config.frames_per_second = 60.0;
+    return config;
+}
+
+bool Validates(const AppConfig& config)
+{
+    try
+    {
+        ValidateConfigOrFail(config);
+        return true;
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+}
+}  // namespace
+
+TEST_CASE(AppConfig_CheapScalingRequiresHalftone)
+{
+    AppConfig config = ValidConfig();
+    config.governor_levels = { "skip_overlay", "cheap_scaling" };
+
+    CHECK(!Validates(config));  // scaling_filter omitted selects nearest
+    config.scaling_filter = "nearest";
+    CHECK(!Validates(config));
+    config.scaling_filter = "halftone";
+    CHECK(Validates(config));
+
+    config.scaling_filter = "nearest";
+    config.governor_levels = { "skip_overlay", "reduce_rate" };
+    CHECK(Validates(config));
+}
@@ -0,0 +1,115 @@
+// CaptureLoopTests.cpp : RunCaptureLoop without a window, presenting into a MemoryPresenter.
+// The capture test needs an interactive desktop session and is skipped when desktop duplication is unavailable.
+
+#include "TestSupport.h"
+
+#include "CaptureEngine.h"
+#include "Presenter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST_CASE(CaptureLoop_HeadlessMemoryPresenter)
+{
+    AppConfig config{};
+    config.display_width = 320;
+    config.display_height = 180;
+    config.record_width = 320;
+    config.record_height = 180;
+    config.zoom_factor = 2.0;  // 160x90 capture, scaled 2x by the presenter
+    config.frames_per_second = 30.0;
+
+    constexpr std::size_t kKeptFrames = 4;
+    const auto presenter = std::make_shared<MemoryPresenter>(config.display_width, config.display_height, kKeptFrames);
+
+    // The frame callback runs just before Present, so it sees exactly what the presenter is given.
+    std::atomic<int> capturedFrames{ 0 };
+    std::mutex lastCaptureMutex;
+    std::vector<std::uint32_t> lastCapture;
+    int lastCaptureWidth = 0;
+    int lastCaptureHeight = 0;
+
+    CaptureRuntimeOptions options{};
+    options.presenter = presenter;
+    options.log = [](const std::string& line) { std::printf("  %s\n", line.c_str()); };
+    options.frame_callback = [&](const CaptureFrameContext& frame) {
+        std::lock_guard<std::mutex> lock(lastCaptureMutex);
+        lastCaptureWidth = frame.capture_width;
+        lastCaptureHeight = frame.capture_height;
+        lastCapture.resize(static_cast<std::size_t>(frame.capture_width) * frame.capture_height);
+        for (int y = 0; y < frame.capture_height; ++y)
+        {
+            std::memcpy(lastCapture.data() + static_cast<std::size_t>(y) * frame.capture_width,
+                static_cast<const std::uint8_t*>(frame.pixels) + static_cast<std::size_t>(y) * frame.pitch,
+                static_cast<std::size_t>(frame.capture_width) * 4);
+        }
+        ++capturedFrames;
+    };
+
+    std::atomic<bool> running{ true };
+    int status = -1;
+    std::thread loop([&]() { status = RunCaptureLoop(nullptr, config, running, options); });
+
+    // Duplication delivers the current desktop image first, then only on change.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (capturedFrames.load() == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    running = false;
+    loop.join();
+
+    if (status == kCaptureStatusInitFailure)
+        SKIP_TEST("desktop duplication is unavailable in this session");
+    CHECK(status == kCaptureStatusSuccess);
+    if (capturedFrames.load() == 0)
+        SKIP_TEST("the desktop produced no frame within 3 seconds");
+
+    const std::vector<PresentedFrame> frames = presenter->TakeFrames();
+    CHECK(frames.size() == std::min<std::size_t>(static_cast<std::size_t>(capturedFrames.load()), kKeptFrames));
+    for (const PresentedFrame& frame : frames)
+    {
+        CHECK(frame.width == config.display_width);
+        CHECK(frame.height == config.display_height);
+        CHECK(!frame.blank);
+        CHECK(frame.pixels.size() == static_cast<std::size_t>(frame.width) * frame.height * 4);
+    }
+    CHECK(lastCaptureWidth == 160);
+    CHECK(lastCaptureHeight == 90);
+    if (frames.empty() || lastCaptureWidth != 160 || lastCaptureHeight != 90)
+        return;
+
+    // At exactly 2x, nearest-neighbour output pixel (x, y) is capture pixel (x / 2, y / 2).
+    const auto* presented = reinterpret_cast<const std::uint32_t*>(frames.back().pixels.data());
+    int mismatches = 0;
+    for (int y = 0; y < config.display_height; ++y)
+    {
+        for (int x = 0; x < config.display_width; ++x)
+        {
+            if (presented[static_cast<std::size_t>(y) * config.display_width + x] != lastCapture[static_cast<std::size_t>(y / 2) * 160 + x / 2])
+                ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE(CaptureLoop_NoWindowNoPresenterFails)
+{
+    // A GdiPresenter on a null window would draw over the whole desktop, so the loop refuses to start.
+    AppConfig config{};
+    config.display_width = 320;
+    config.display_height = 180;
+    config.record_width = 320;
+    config.record_height = 180;
+    config.zoom_factor = 2.0;
+    config.frames_per_second = 30.0;
+
+    std::atomic<bool> running{ true };
+    CHECK(RunCaptureLoop(nullptr, config, running, CaptureRuntimeOptions{}) == kCaptureStatusInitFailure);
+}
@@ -0,0 +1,132 @@
+// PixelConversionTests.cpp : the SIMD converters must match ConvertRegionScalar bit for bit.
+
+#include "TestSupport.h"
+
+#include "PixelConversion.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr DXGI_FORMAT kFormats[] = {
+    DXGI_FORMAT_R16G16B16A16_FLOAT,
+    DXGI_FORMAT_R10G10B10A2_UNORM,
+    DXGI_FORMAT_R8G8B8A8_UNORM,
+    DXGI_FORMAT_B8G8R8A8_UNORM,
+};
+constexpr ToneMapCurve kCurves[] = { kToneMapClamp, kToneMapReinhard, kToneMapAces };
+
+// Widths around the 4- and 8-pixel SIMD steps so the scalar tails are covered too.
+constexpr int kWidths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 63, 257 };
+
+std::uint16_t FloatToHalf(float value)
+{
+    // Only used for exact test values, so truncation is fine.
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const int exponent = static_cast<int>((bits >> 23) & 0xFFu) - 127 + 15;
+    if (exponent <= 0)
+        return static_cast<std::uint16_t>(sign);
+    if (exponent >= 31)
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    return static_cast<std::uint16_t>(sign | (exponent << 10) | ((bits >> 13) & 0x3FFu));
+}
+
+// Converts one region both ways; the source rows carry padding so pitch != width * bpp.
+bool SimdMatchesScalar(const PixelConverter& converter, const std::vector<std::uint8_t>& source, int src_pitch, int width, int height)
+{
+    const int dstPitch = width * 4;
+    std::vector<std::uint8_t> simd(static_cast<std::size_t>(dstPitch) * height, 0xCD);
+    std::vector<std::uint8_t> scalar(simd.size(), 0xCD);
+    converter.ConvertRegion(source.data(), src_pitch, simd.data(), dstPitch, width, height);
+    converter.ConvertRegionScalar(source.data(), src_pitch, scalar.data(), dstPitch, width, height);
+    return simd == scalar;
+}
+}  // namespace
+
+TEST_CASE(PixelConversion_SimdMatchesScalarOnRandomBits)
+{
+    // Random bytes include NaN, infinity, negative and denormal halves.
+    std::mt19937 rng(1234);
+    for (DXGI_FORMAT format : kFormats)
+    {
+        for (ToneMapCurve curve : kCurves)
+        {
+            const PixelConverter converter(format, ToneMapSettings{ curve, 0.75f });
+            CHECK(converter.IsSupported());
+            for (int width : kWidths)
+            {
+                const int height = 3;
+                const int srcPitch = width * converter.BytesPerPixel() + 24;
+                std::vector<std::uint8_t> source(static_cast<std::size_t>(srcPitch) * height);
+                for (std::uint8_t& byte : source)
+                    byte = static_cast<std::uint8_t>(rng());
+
+                const bool match = SimdMatchesScalar(converter, source, srcPitch, width, height);
+                if (!match)
+                    std::printf("  format %d curve %d width %d\n", static_cast<int>(format), static_cast<int>(curve), width);
+                CHECK(match);
+            }
+        }
+    }
+}
+
+TEST_CASE(PixelConversion_SimdMatchesScalarOnHdrRange)
+{
+    // Linear scRGB from black to well above SDR white, where the curves differ most.
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> linear(0.0f, 12.0f);
+    for (ToneMapCurve curve : kCurves)
+    {
+        for (float exposure : { 0.25f, 1.0f, 3.0f })
+        {
+            const PixelConverter converter(DXGI_FORMAT_R16G16B16A16_FLOAT, ToneMapSettings{ curve, exposure });
+            const int width = 259;
+            const int height = 4;
+            const int srcPitch = width * 8;
+            std::vector<std::uint8_t> source(static_cast<std::size_t>(srcPitch) * height);
+            auto* halves = reinterpret_cast<std::uint16_t*>(source.data());
+            for (std::size_t i = 0; i < source.size() / 2; ++i)
+                halves[i] = FloatToHalf(linear(rng));
+
+            CHECK(SimdMatchesScalar(converter, source, srcPitch, width, height));
+        }
+    }
+}
+
+TEST_CASE(PixelConversion_Fp16KnownValues)
+{
+    // Clamp at exposure 1: 0.0 -> 0, 1.0 (SDR white) and above -> 255, alpha always opaque.
+    const PixelConverter converter(DXGI_FORMAT_R16G16B16A16_FLOAT, ToneMapSettings{ kToneMapClamp, 1.0f });
+    const std::uint16_t source[] = {
+        FloatToHalf(1.0f), FloatToHalf(0.0f), FloatToHalf(4.0f), FloatToHalf(0.0f),    // r=1 g=0 b=4 a=0
+        FloatToHalf(0.0f), FloatToHalf(1.0f), FloatToHalf(-1.0f), FloatToHalf(1.0f),   // r=0 g=1 b=-1 a=1
+    };
+    std::uint32_t simd[2] = {};
+    std::uint32_t scalar[2] = {};
+    converter.ConvertRegion(source, sizeof(source), simd, sizeof(simd), 2, 1);
+    converter.ConvertRegionScalar(source, sizeof(source), scalar, sizeof(scalar), 2, 1);
+
+    CHECK(scalar[0] == 0xFFFF00FFu);
+    CHECK(scalar[1] == 0xFF00FF00u);
+    CHECK(simd[0] == scalar[0]);
+    CHECK(simd[1] == scalar[1]);
+}
+
+TEST_CASE(PixelConversion_R10G10B10A2KnownValues)
+{
+    // r = 1023, g = 0, b = 512: expands to 255, 0, 128 in BGRA order.
+    const PixelConverter converter(DXGI_FORMAT_R10G10B10A2_UNORM, ToneMapSettings{ kToneMapReinhard, 1.0f });
+    const std::uint32_t source[] = { 1023u | (0u << 10) | (512u << 20) | (3u << 30) };
+    std::uint32_t simd = 0;
+    std::uint32_t scalar = 0;
+    converter.ConvertRegion(source, sizeof(source), &simd, sizeof(simd), 1, 1);
+    converter.ConvertRegionScalar(source, sizeof(source), &scalar, sizeof(scalar), 1, 1);
+
+    CHECK(scalar == 0xFFFF0080u);
+    CHECK(simd == scalar);
+}
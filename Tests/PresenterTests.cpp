@@ -0,0 +1,69 @@
+// PresenterTests.cpp : MemoryPresenter scaling and frame retention, without a desktop or window.
+
+#include "TestSupport.h"
+
+#include "Presenter.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+std::uint32_t PixelAt(const PresentedFrame& frame, int x, int y)
+{
+    return reinterpret_cast<const std::uint32_t*>(frame.pixels.data())[static_cast<std::size_t>(y) * frame.width + x];
+}
+}  // namespace
+
+TEST_CASE(MemoryPresenter_ScalesNearestNeighbour)
+{
+    // 4x2 source with a padded pitch, shown at 2x: every source pixel becomes a 2x2 block.
+    const int pitch = 6 * 4;
+    std::vector<std::uint32_t> source(6 * 2);
+    for (int y = 0; y < 2; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+            source[static_cast<std::size_t>(y) * 6 + x] = 0xFF000000u | static_cast<std::uint32_t>(y * 16 + x);
+    }
+
+    MemoryPresenter presenter(8, 4, 2);
+    presenter.Present(CaptureFrameContext{ nullptr, source.data(), pitch, 4, 2 });
+    const std::vector<PresentedFrame> frames = presenter.TakeFrames();
+    CHECK(frames.size() == 1);
+    if (frames.empty())
+        return;
+
+    const PresentedFrame& frame = frames[0];
+    CHECK(frame.width == 8);
+    CHECK(frame.height == 4);
+    CHECK(!frame.blank);
+    CHECK(frame.pixels.size() == 8u * 4u * 4u);
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+            CHECK(PixelAt(frame, x, y) == (0xFF000000u | static_cast<std::uint32_t>((y / 2) * 16 + x / 2)));
+    }
+}
+
+TEST_CASE(MemoryPresenter_KeepsMostRecentFrames)
+{
+    std::uint32_t pixel = 0;
+    MemoryPresenter presenter(1, 1, 3);
+    for (std::uint32_t i = 1; i <= 5; ++i)
+    {
+        pixel = i;
+        presenter.Present(CaptureFrameContext{ nullptr, &pixel, 4, 1, 1 });
+    }
+    presenter.PresentBlank();
+
+    const std::vector<PresentedFrame> frames = presenter.TakeFrames();
+    CHECK(frames.size() == 3);
+    if (frames.size() == 3)
+    {
+        CHECK(PixelAt(frames[0], 0, 0) == 4u);
+        CHECK(PixelAt(frames[1], 0, 0) == 5u);
+        CHECK(frames[2].blank);
+        CHECK(PixelAt(frames[2], 0, 0) == 0u);
+    }
+    CHECK(presenter.TakeFrames().empty());
+}
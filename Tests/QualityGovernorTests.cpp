@@ -0,0 +1,153 @@
+// QualityGovernorTests.cpp : drives QualityGovernor with a synthetic frame source of known cost.
+
+#include "TestSupport.h"
+
+#include "QualityGovernor.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double kBudgetMs = 1000.0 / 60.0;
+
+// Produces frames whose total work is a chosen share of the budget, split across the stages the
+// way a real frame is (mostly capture, then present, then overlay).
+class SyntheticFrameSource
+{
+public:
+    explicit SyntheticFrameSource(QualityGovernor& governor)
+        : governor_(governor)
+    {
+    }
+
+    // Feeds whole decision windows at budget_share of the budget. Returns how many frames changed the level.
+    int FeedWindows(int windows, double budget_share)
+    {
+        int changes = 0;
+        for (int i = 0; i < windows * kWindowFrames; ++i)
+        {
+            if (FeedFrame(budget_share))
+                ++changes;
+        }
+        return changes;
+    }
+
+    bool FeedFrame(double budget_share)
+    {
+        const double work = kBudgetMs * budget_share;
+        const bool changed = governor_.OnFrame(FrameStageTimings{ work * 0.6, work * 0.1, work * 0.3 });
+        CHECK(governor_.Level() >= 0);
+        CHECK(governor_.Level() <= governor_.MaxLevel());
+        return changed;
+    }
+
+    static constexpr int kWindowFrames = 30;
+
+private:
+    QualityGovernor& governor_;
+};
+
+QualityGovernorSettings DefaultSettings()
+{
+    QualityGovernorSettings settings{};
+    settings.frame_budget_ms = kBudgetMs;
+    settings.levels = { kDegradeCheapScaling, kDegradeSkipOverlay, kDegradeReduceRate };
+    return settings;
+}
+}  // namespace
+
+TEST_CASE(QualityGovernor_StepsDownAfterOneSlowWindow)
+{
+    std::vector<std::string> lines;
+    QualityGovernor governor(DefaultSettings(), [&lines](const std::string& line) { lines.push_back(line); });
+    SyntheticFrameSource source(governor);
+
+    // No decision until the window is full.
+    for (int i = 0; i < SyntheticFrameSource::kWindowFrames - 1; ++i)
+        CHECK(!source.FeedFrame(0.95));
+    CHECK(governor.Level() == 0);
+
+    CHECK(source.FeedFrame(0.95));
+    CHECK(governor.Level() == 1);
+    CHECK(governor.State().cheap_scaling);
+    CHECK(!governor.State().skip_alternate_overlay);
+    CHECK(lines.size() == 1);
+    CHECK(!lines.empty() && lines[0].find("cheap_scaling") != std::string::npos);
+
+    CHECK(source.FeedWindows(1, 0.95) == 1);
+    CHECK(governor.Level() == 2);
+    CHECK(governor.State().skip_alternate_overlay);
+}
+
+TEST_CASE(QualityGovernor_StepsUpOnlyAfterThreeCalmWindows)
+{
+    QualityGovernor governor(DefaultSettings(), [](const std::string&) {});
+    SyntheticFrameSource source(governor);
+    source.FeedWindows(2, 1.2);
+    CHECK(governor.Level() == 2);
+
+    CHECK(source.FeedWindows(2, 0.5) == 0);
+    CHECK(governor.Level() == 2);
+    CHECK(source.FeedWindows(1, 0.5) == 1);
+    CHECK(governor.Level() == 1);
+
+    // The calm count restarts after each step up.
+    CHECK(source.FeedWindows(2, 0.5) == 0);
+    CHECK(governor.Level() == 1);
+    CHECK(source.FeedWindows(1, 0.5) == 1);
+    CHECK(governor.Level() == 0);
+    CHECK(!governor.State().cheap_scaling);
+}
+
+TEST_CASE(QualityGovernor_HoldsInsideTheHysteresisBand)
+{
+    QualityGovernor governor(DefaultSettings(), [](const std::string&) {});
+    SyntheticFrameSource source(governor);
+    source.FeedWindows(1, 1.0);
+    CHECK(governor.Level() == 1);
+
+    // 60-90% of the budget neither steps down nor counts as calm.
+    for (double share : { 0.61, 0.75, 0.89 })
+    {
+        CHECK(source.FeedWindows(5, share) == 0);
+        CHECK(governor.Level() == 1);
+    }
+
+    // A band window in between resets the calm streak.
+    source.FeedWindows(2, 0.5);
+    source.FeedWindows(1, 0.75);
+    CHECK(source.FeedWindows(2, 0.5) == 0);
+    CHECK(governor.Level() == 1);
+    CHECK(source.FeedWindows(1, 0.5) == 1);
+    CHECK(governor.Level() == 0);
+}
+
+TEST_CASE(QualityGovernor_StaysWithinMaxLevel)
+{
+    QualityGovernorSettings settings = DefaultSettings();
+    settings.levels = { kDegradeSkipOverlay, kDegradeReduceRate };
+    QualityGovernor governor(settings, [](const std::string&) {});
+    SyntheticFrameSource source(governor);
+    CHECK(governor.MaxLevel() == 2);
+
+    CHECK(source.FeedWindows(10, 3.0) == 2);
+    CHECK(governor.Level() == governor.MaxLevel());
+    const QualityState state = governor.State();
+    CHECK(!state.cheap_scaling);
+    CHECK(state.skip_alternate_overlay);
+    CHECK(state.reduced_rate);
+
+    CHECK(source.FeedWindows(20, 0.1) == 2);
+    CHECK(governor.Level() == 0);
+}
+
+TEST_CASE(QualityGovernor_NoLevelsNeverMoves)
+{
+    QualityGovernorSettings settings = DefaultSettings();
+    settings.levels.clear();
+    QualityGovernor governor(settings, [](const std::string&) {});
+    SyntheticFrameSource source(governor);
+    CHECK(source.FeedWindows(5, 2.0) == 0);
+    CHECK(governor.Level() == 0);
+}
@@ -0,0 +1,217 @@
+// StreamProtocolTests.cpp : EncodeTile/DecodeTile must round-trip every tile shape and content.
+
+#include "TestSupport.h"
+
+#include "StreamProtocol.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct TileShape
+{
+    int width;
+    int height;
+};
+
+// Full tiles at the usual sizes plus the partial tiles found on the right and bottom frame edges.
+constexpr TileShape kShapes[] = { { 1, 1 }, { 1, 9 }, { 7, 3 }, { 64, 64 }, { 300, 2 }, { 17, 64 }, { 64, 5 } };
+
+enum TileContent
+{
+    kContentSolid,    // one run per 256 pixels
+    kContentBands,    // long runs that cross row ends
+    kContentText,     // short runs, the usual UI case
+    kContentNoise     // every pixel differs, RLE loses to raw
+};
+
+// Fills a frame wider than the tile so the source pitch differs from tile_width * 4.
+std::vector<std::uint8_t> MakeFrame(TileContent content, int pitch, int height, std::mt19937& rng)
+{
+    std::vector<std::uint8_t> frame(static_cast<std::size_t>(pitch) * height);
+    auto* pixels = reinterpret_cast<std::uint32_t*>(frame.data());
+    const std::size_t count = frame.size() / 4;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        switch (content)
+        {
+        case kContentSolid: pixels[i] = 0xFF202020u; break;
+        case kContentBands: pixels[i] = 0xFF000000u | static_cast<std::uint32_t>(i / 700) * 0x010101u; break;
+        case kContentText: pixels[i] = (rng() % 5 == 0) ? 0xFF000000u : 0xFFFFFFFFu; break;
+        case kContentNoise: pixels[i] = static_cast<std::uint32_t>(rng()); break;
+        }
+    }
+    return frame;
+}
+
+bool TilesEqual(const std::uint8_t* a, int pitch_a, const std::uint8_t* b, int pitch_b, int tile_width, int tile_height)
+{
+    for (int y = 0; y < tile_height; ++y)
+    {
+        if (std::memcmp(a + static_cast<std::size_t>(y) * pitch_a, b + static_cast<std::size_t>(y) * pitch_b, static_cast<std::size_t>(tile_width) * 4) != 0)
+            return false;
+    }
+    return true;
+}
+}  // namespace
+
+TEST_CASE(StreamProtocol_TileRoundTrip)
+{
+    std::mt19937 rng(42);
+    for (TileContent content : { kContentSolid, kContentBands, kContentText, kContentNoise })
+    {
+        for (const TileShape& shape : kShapes)
+        {
+            const int pitch = (shape.width + 13) * 4;
+            const std::vector<std::uint8_t> frame = MakeFrame(content, pitch, shape.height, rng);
+
+            // Encode after existing bytes, as SendFrame does, to check EncodeTile only appends.
+            std::vector<std::uint8_t> out(11, 0xAB);
+            const StreamTileEncoding encoding = EncodeTile(frame.data(), pitch, shape.width, shape.height, out);
+            const std::size_t encodedBytes = out.size() - 11;
+            const std::size_t rawBytes = static_cast<std::size_t>(shape.width) * shape.height * 4;
+            CHECK(out[10] == 0xAB);
+            CHECK(encodedBytes <= rawBytes);
+            if (content == kContentSolid && rawBytes > 5)
+                CHECK(encoding == kTileEncodingRle);
+            if (content == kContentNoise)
+                CHECK(encoding == kTileEncodingRaw);
+
+            // Decode into a frame with a different pitch and a poisoned background.
+            const int decodedPitch = (shape.width + 3) * 4;
+            std::vector<std::uint8_t> decoded(static_cast<std::size_t>(decodedPitch) * shape.height, 0xCD);
+            const bool ok = DecodeTile(encoding, out.data() + 11, encodedBytes, decoded.data(), decodedPitch, shape.width, shape.height);
+            CHECK(ok);
+            const bool equal = TilesEqual(frame.data(), pitch, decoded.data(), decodedPitch, shape.width, shape.height);
+            if (!ok || !equal)
+                std::printf("  content %d tile %dx%d encoding %d\n", static_cast<int>(content), shape.width, shape.height, static_cast<int>(encoding));
+            CHECK(equal);
+            CHECK(decoded[static_cast<std::size_t>(shape.width) * 4] == 0xCD);  // padding after row 0 untouched
+        }
+    }
+}
+
+TEST_CASE(StreamProtocol_DecodeRejectsMalformedTiles)
+{
+    const int width = 8;
+    const int height = 4;
+    std::vector<std::uint8_t> solid(static_cast<std::size_t>(width) * height * 4, 0x11);
+    std::vector<std::uint8_t> rle;
+    CHECK(EncodeTile(solid.data(), width * 4, width, height, rle) == kTileEncodingRle);
+
+    std::vector<std::uint8_t> decoded(solid.size());
+    CHECK(DecodeTile(kTileEncodingRle, rle.data(), rle.size(), decoded.data(), width * 4, width, height));
+
+    // Truncated run record, short raw payload, unknown encoding.
+    CHECK(!DecodeTile(kTileEncodingRle, rle.data(), rle.size() - 1, decoded.data(), width * 4, width, height));
+    CHECK(!DecodeTile(kTileEncodingRaw, solid.data(), solid.size() - 4, decoded.data(), width * 4, width, height));
+    CHECK(!DecodeTile(static_cast<StreamTileEncoding>(7), rle.data(), rle.size(), decoded.data(), width * 4, width, height));
+
+    // Runs covering fewer or more pixels than the tile holds.
+    CHECK(!DecodeTile(kTileEncodingRle, rle.data(), rle.size(), decoded.data(), width * 4, width, height + 1));
+    CHECK(!DecodeTile(kTileEncodingRle, rle.data(), rle.size(), decoded.data(), width * 4, width, height - 1));
+}
+
+namespace
+{
+// Builds a frame payload the way TileStreamSink::SendFrame does, from every tile of pixels.
+std::vector<std::uint8_t> EncodeFramePayload(const std::vector<std::uint8_t>& pixels, int width, int height, int tile_size,
+    StreamFrameHeader& header)
+{
+    std::vector<std::uint8_t> payload;
+    std::uint32_t tileCount = 0;
+    for (int ty = 0; ty * tile_size < height; ++ty)
+    {
+        for (int tx = 0; tx * tile_size < width; ++tx)
+        {
+            const int x0 = tx * tile_size;
+            const int y0 = ty * tile_size;
+            const std::size_t headerOffset = payload.size();
+            payload.resize(headerOffset + sizeof(StreamTileHeader));
+            StreamTileHeader tile = {};
+            tile.tile_x = static_cast<std::uint16_t>(tx);
+            tile.tile_y = static_cast<std::uint16_t>(ty);
+            tile.encoding = EncodeTile(pixels.data() + (static_cast<std::size_t>(y0) * width + x0) * 4, width * 4,
+                std::min(tile_size, width - x0), std::min(tile_size, height - y0), payload);
+            tile.data_bytes = static_cast<std::uint32_t>(payload.size() - headerOffset - sizeof(StreamTileHeader));
+            std::memcpy(payload.data() + headerOffset, &tile, sizeof(tile));
+            ++tileCount;
+        }
+    }
+
+    header = StreamFrameHeader{};
+    header.magic = kStreamMagic;
+    header.version = kStreamVersion;
+    header.flags = kStreamFlagKeyframe;
+    header.width = static_cast<std::uint32_t>(width);
+    header.height = static_cast<std::uint32_t>(height);
+    header.tile_size = static_cast<std::uint16_t>(tile_size);
+    header.tile_count = tileCount;
+    header.payload_bytes = static_cast<std::uint32_t>(payload.size());
+    return payload;
+}
+}  // namespace
+
+TEST_CASE(StreamProtocol_FrameRoundTrip)
+{
+    // 100x70 with 32 px tiles leaves partial tiles on the right and bottom edges.
+    const int width = 100;
+    const int height = 70;
+    std::mt19937 rng(5);
+    const std::vector<std::uint8_t> pixels = MakeFrame(kContentText, width * 4, height, rng);
+
+    StreamFrameHeader header;
+    const std::vector<std::uint8_t> payload = EncodeFramePayload(pixels, width, height, 32, header);
+    CHECK(header.tile_count == 4u * 3u);
+
+    std::vector<std::uint8_t> frame(pixels.size(), 0);
+    CHECK(DecodeFrame(header, payload, frame));
+    CHECK(frame == pixels);
+}
+
+TEST_CASE(StreamProtocol_DecodeFrameRejectsMalformedPayloads)
+{
+    const int width = 40;
+    const int height = 24;
+    std::mt19937 rng(6);
+    const std::vector<std::uint8_t> pixels = MakeFrame(kContentBands, width * 4, height, rng);
+    StreamFrameHeader header;
+    const std::vector<std::uint8_t> payload = EncodeFramePayload(pixels, width, height, 16, header);
+    std::vector<std::uint8_t> frame(pixels.size());
+
+    // Every truncation point, including inside a tile header, must fail rather than read past the end.
+    for (std::size_t size = 0; size < payload.size(); ++size)
+    {
+        const std::vector<std::uint8_t> truncated(payload.begin(), payload.begin() + static_cast<std::ptrdiff_t>(size));
+        if (DecodeFrame(header, truncated, frame))
+        {
+            std::printf("  accepted a payload truncated to %zu of %zu bytes\n", size, payload.size());
+            CHECK(false);
+            break;
+        }
+    }
+
+    std::vector<std::uint8_t> trailing = payload;
+    trailing.push_back(0);
+    CHECK(!DecodeFrame(header, trailing, frame));
+
+    StreamFrameHeader moreTiles = header;
+    ++moreTiles.tile_count;
+    CHECK(!DecodeFrame(moreTiles, payload, frame));
+
+    StreamFrameHeader narrower = header;
+    narrower.width = 16;  // first row's second tile now starts past the right edge
+    std::vector<std::uint8_t> narrowFrame(static_cast<std::size_t>(16) * height * 4);
+    CHECK(!DecodeFrame(narrower, payload, narrowFrame));
+
+    StreamFrameHeader noTiles = header;
+    noTiles.tile_size = 0;
+    CHECK(!DecodeFrame(noTiles, payload, frame));
+
+    std::vector<std::uint8_t> smallFrame(frame.size() - 4);
+    CHECK(!DecodeFrame(header, payload, smallFrame));
+}
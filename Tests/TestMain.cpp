@@ -0,0 +1,65 @@
+// TestMain.cpp : runs every registered test case, or only those whose name contains argv[1].
+// Exits non-zero if any CHECK failed or a test threw.
+
+#include "TestSupport.h"
+
+#include <cstring>
+#include <exception>
+
+std::vector<TestCase>& TestRegistry()
+{
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+int& TestFailureCount()
+{
+    static int failures = 0;
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    int failed = 0;
+    int skipped = 0;
+
+    for (const TestCase& test : TestRegistry())
+    {
+        if (filter && std::strstr(test.name, filter) == nullptr)
+            continue;
+
+        std::printf("[ RUN  ] %s\n", test.name);
+        const int failuresBefore = TestFailureCount();
+        try
+        {
+            test.run();
+        }
+        catch (const TestSkipped& skip)
+        {
+            std::printf("[ SKIP ] %s: %s\n", test.name, skip.what());
+            ++skipped;
+            continue;
+        }
+        catch (const std::exception& ex)
+        {
+            std::printf("  unexpected exception: %s\n", ex.what());
+            ++TestFailureCount();
+        }
+
+        ++run;
+        if (TestFailureCount() != failuresBefore)
+        {
+            std::printf("[ FAIL ] %s\n", test.name);
+            ++failed;
+        }
+        else
+        {
+            std::printf("[  OK  ] %s\n", test.name);
+        }
+    }
+
+    std::printf("%d run, %d failed, %d skipped\n", run, failed, skipped);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test harness for FastMagStream.Tests. Each TEST_CASE runs once;
+// CHECK records a failure and keeps going, SKIP_TEST ends the case without failing it.
+
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& TestRegistry();
+int& TestFailureCount();
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, void (*run)()) { TestRegistry().push_back({ name, run }); }
+};
+
+struct TestSkipped : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+#define TEST_CASE(name)                                          \
+    static void name();                                          \
+    static const TestRegistrar name##_registrar(#name, &name);   \
+    static void name()
+
+#define CHECK(expr)                                                                      \
+    do                                                                                   \
+    {                                                                                    \
+        if (!(expr))                                                                     \
+        {                                                                                \
+            ++TestFailureCount();                                                        \
+            std::printf("  %s(%d): CHECK failed: %s\n", __FILE__, __LINE__, #expr);     \
+        }                                                                                \
+    } while (0)
+
+#define SKIP_TEST(reason) throw TestSkipped(reason)
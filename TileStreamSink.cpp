@@ -0,0 +1,287 @@
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+
+// winsock2.h has to precede Windows.h, which TileStreamSink.h pulls in through CaptureEngine.h.
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "TileStreamSink.h"
+#include "StreamProtocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace
+{
+bool SendAll(SOCKET socket, const std::uint8_t* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const int chunk = static_cast<int>(std::min<std::size_t>(size, 1 << 20));
+        const int sent = send(socket, reinterpret_cast<const char*>(data), chunk, 0);
+        if (sent == SOCKET_ERROR || sent == 0)
+            return false;
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool TileChanged(const std::uint8_t* current, const std::uint8_t* previous, int pitch, int tile_width, int tile_height)
+{
+    const std::size_t rowBytes = static_cast<std::size_t>(tile_width) * 4;
+    for (int y = 0; y < tile_height; ++y, current += pitch, previous += pitch)
+    {
+        if (std::memcmp(current, previous, rowBytes) != 0)
+            return true;
+    }
+    return false;
+}
+}  // namespace
+
+struct TileStreamSink::Sockets
+{
+    bool wsa_started = false;
+    SOCKET listen_socket = INVALID_SOCKET;
+    std::mutex client_mutex;  // lets Stop() shut down a client the sender is blocked on
+    SOCKET client_socket = INVALID_SOCKET;
+};
+
+TileStreamSink::TileStreamSink(const TileStreamOptions& options)
+    : options_(options)
+    , sockets_(std::make_unique<Sockets>())
+{
+}
+
+TileStreamSink::~TileStreamSink()
+{
+    Stop();
+}
+
+bool TileStreamSink::Start()
+{
+    if (running_.load())
+        return true;
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+        return false;
+    sockets_->wsa_started = true;
+
+    SOCKET listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenSocket == INVALID_SOCKET) { Stop(); return false; }
+    sockets_->listen_socket = listenSocket;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<u_short>(options_.port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+        listen(listenSocket, 1) == SOCKET_ERROR)
+    {
+        Stop();
+        return false;
+    }
+
+    running_ = true;
+    sender_thread_ = std::thread(&TileStreamSink::SenderMain, this);
+    return true;
+}
+
+void TileStreamSink::Stop()
+{
+    running_ = false;
+    mailbox_cv_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(sockets_->client_mutex);
+        if (sockets_->client_socket != INVALID_SOCKET)
+            shutdown(sockets_->client_socket, SD_BOTH);
+    }
+
+    if (sender_thread_.joinable())
+        sender_thread_.join();
+
+    CloseClient();
+    if (sockets_->listen_socket != INVALID_SOCKET)
+    {
+        closesocket(sockets_->listen_socket);
+        sockets_->listen_socket = INVALID_SOCKET;
+    }
+    if (sockets_->wsa_started)
+    {
+        WSACleanup();
+        sockets_->wsa_started = false;
+    }
+}
+
+void TileStreamSink::SubmitFrame(const CaptureFrameContext& frame)
+{
+    const std::uint32_t frameIndex = next_frame_index_++;
+    if (!client_connected_.load())
+        return;
+
+    staging_.capture_time_us = StreamClockMicroseconds();
+    staging_.frame_index = frameIndex;
+    staging_.width = frame.capture_width;
+    staging_.height = frame.capture_height;
+
+    const std::size_t rowBytes = static_cast<std::size_t>(frame.capture_width) * 4;
+    staging_.pixels.resize(rowBytes * frame.capture_height);
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(frame.pixels);
+    std::uint8_t* dst = staging_.pixels.data();
+    for (int y = 0; y < frame.capture_height; ++y, src += frame.pitch, dst += rowBytes)
+        std::memcpy(dst, src, rowBytes);
+
+    {
+        std::lock_guard<std::mutex> lock(mailbox_mutex_);
+        if (has_pending_)
+            ++dropped_frames_;
+        std::swap(staging_, pending_);
+        has_pending_ = true;
+    }
+    mailbox_cv_.notify_one();
+}
+
+void TileStreamSink::SenderMain()
+{
+    while (running_.load())
+    {
+        if (!client_connected_.load())
+        {
+            if (!AcceptClient())
+                continue;
+            frames_since_keyframe_ = options_.keyframe_interval;  // a new client starts on a keyframe
+            client_connected_at_us_ = StreamClockMicroseconds();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mailbox_mutex_);
+            mailbox_cv_.wait_for(lock, std::chrono::milliseconds(100), [this]() { return has_pending_ || !running_.load(); });
+            if (!has_pending_)
+                continue;
+            std::swap(pending_, working_);
+            has_pending_ = false;
+        }
+
+        // A SubmitFrame already past its client_connected_ check when the previous client went away
+        // can still post afterwards; its frame would reach the new client as a latency spike.
+        if (working_.capture_time_us < client_connected_at_us_)
+            continue;
+
+        const bool keyframe = frames_since_keyframe_ >= options_.keyframe_interval ||
+            working_.width != previous_.width || working_.height != previous_.height;
+        if (!SendFrame(working_, keyframe))
+        {
+            CloseClient();
+            continue;
+        }
+
+        frames_since_keyframe_ = keyframe ? 1 : frames_since_keyframe_ + 1;
+        std::swap(working_, previous_);
+    }
+}
+
+bool TileStreamSink::AcceptClient()
+{
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET(sockets_->listen_socket, &readSet);
+    timeval timeout = { 0, 100 * 1000 };
+    if (select(0, &readSet, nullptr, nullptr, &timeout) <= 0)
+        return false;
+
+    SOCKET client = accept(sockets_->listen_socket, nullptr, nullptr);
+    if (client == INVALID_SOCKET)
+        return false;
+
+    BOOL noDelay = TRUE;
+    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+    DiscardPendingFrame();
+    {
+        std::lock_guard<std::mutex> lock(sockets_->client_mutex);
+        sockets_->client_socket = client;
+    }
+    client_connected_ = true;
+    return true;
+}
+
+void TileStreamSink::CloseClient()
+{
+    client_connected_ = false;
+    DiscardPendingFrame();
+    std::lock_guard<std::mutex> lock(sockets_->client_mutex);
+    if (sockets_->client_socket != INVALID_SOCKET)
+    {
+        closesocket(sockets_->client_socket);
+        sockets_->client_socket = INVALID_SOCKET;
+    }
+}
+
+void TileStreamSink::DiscardPendingFrame()
+{
+    // A frame captured for one client must never be the first thing the next client sees.
+    std::lock_guard<std::mutex> lock(mailbox_mutex_);
+    has_pending_ = false;
+}
+
+bool TileStreamSink::SendFrame(const FrameBuffer& frame, bool keyframe)
+{
+    const int tileSize = options_.tile_size;
+    const int tilesX = (frame.width + tileSize - 1) / tileSize;
+    const int tilesY = (frame.height + tileSize - 1) / tileSize;
+    const int pitch = frame.width * 4;
+
+    // RLE never exceeds raw, so this bounds the packet and the loop below never reallocates.
+    packet_.clear();
+    packet_.reserve(sizeof(StreamFrameHeader) + static_cast<std::size_t>(tilesX) * tilesY * sizeof(StreamTileHeader) + frame.pixels.size());
+    packet_.resize(sizeof(StreamFrameHeader));
+
+    std::uint32_t tileCount = 0;
+    for (int ty = 0; ty < tilesY; ++ty)
+    {
+        const int y0 = ty * tileSize;
+        const int tileHeight = std::min(tileSize, frame.height - y0);
+        for (int tx = 0; tx < tilesX; ++tx)
+        {
+            const int x0 = tx * tileSize;
+            const int tileWidth = std::min(tileSize, frame.width - x0);
+            const std::size_t offset = static_cast<std::size_t>(y0) * pitch + static_cast<std::size_t>(x0) * 4;
+            const std::uint8_t* tile = frame.pixels.data() + offset;
+
+            if (!keyframe && !TileChanged(tile, previous_.pixels.data() + offset, pitch, tileWidth, tileHeight))
+                continue;
+
+            const std::size_t headerOffset = packet_.size();
+            packet_.resize(headerOffset + sizeof(StreamTileHeader));
+            StreamTileHeader tileHeader = {};
+            tileHeader.tile_x = static_cast<std::uint16_t>(tx);
+            tileHeader.tile_y = static_cast<std::uint16_t>(ty);
+            tileHeader.encoding = EncodeTile(tile, pitch, tileWidth, tileHeight, packet_);
+            tileHeader.data_bytes = static_cast<std::uint32_t>(packet_.size() - headerOffset - sizeof(StreamTileHeader));
+            std::memcpy(packet_.data() + headerOffset, &tileHeader, sizeof(tileHeader));
+            ++tileCount;
+        }
+    }
+
+    StreamFrameHeader header = {};
+    header.magic = kStreamMagic;
+    header.version = kStreamVersion;
+    header.flags = keyframe ? kStreamFlagKeyframe : 0;
+    header.frame_index = frame.frame_index;
+    header.capture_time_us = frame.capture_time_us;
+    header.width = static_cast<std::uint32_t>(frame.width);
+    header.height = static_cast<std::uint32_t>(frame.height);
+    header.tile_size = static_cast<std::uint16_t>(tileSize);
+    header.tile_count = tileCount;
+    header.payload_bytes = static_cast<std::uint32_t>(packet_.size() - sizeof(StreamFrameHeader));
+    std::memcpy(packet_.data(), &header, sizeof(header));
+
+    // Only this thread assigns client_socket, so it can be read without the lock here.
+    return SendAll(sockets_->client_socket, packet_.data(), packet_.size());
+}
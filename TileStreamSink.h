@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CaptureEngine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct TileStreamOptions
+{
+    int port;               // loopback TCP port
+    int tile_size;          // tile edge in pixels
+    int keyframe_interval;  // frames between forced keyframes
+};
+
+// Streams captured frames to one local client as changed, RLE-compressed tiles (see StreamProtocol.h).
+// SubmitFrame only copies into a mailbox slot; diffing, encoding and sending happen on a sender thread.
+// If the client reads slower than the capture rate, unsent frames are replaced rather than queued.
+class TileStreamSink
+{
+public:
+    explicit TileStreamSink(const TileStreamOptions& options);
+    ~TileStreamSink();
+
+    TileStreamSink(const TileStreamSink&) = delete;
+    TileStreamSink& operator=(const TileStreamSink&) = delete;
+
+    // Binds 127.0.0.1:port and starts the sender thread. Returns false if the socket cannot be set up.
+    bool Start();
+    void Stop();
+
+    // Called on the capture thread. No-op while no client is connected.
+    void SubmitFrame(const CaptureFrameContext& frame);
+
+    // Frames replaced in the mailbox before the sender got to them, since Start.
+    std::uint64_t DroppedFrames() const { return dropped_frames_.load(); }
+
+private:
+    struct FrameBuffer
+    {
+        std::vector<std::uint8_t> pixels;  // tightly packed BGRA
+        int width = 0;
+        int height = 0;
+        std::uint32_t frame_index = 0;
+        std::uint64_t capture_time_us = 0;
+    };
+    struct Sockets;
+
+    void SenderMain();
+    bool AcceptClient();
+    void CloseClient();
+    void DiscardPendingFrame();
+    bool SendFrame(const FrameBuffer& frame, bool keyframe);
+
+    TileStreamOptions options_;
+    std::unique_ptr<Sockets> sockets_;
+    std::thread sender_thread_;
+    std::atomic<bool> running_{ false };
+    std::atomic<bool> client_connected_{ false };
+    std::atomic<std::uint64_t> dropped_frames_{ 0 };
+
+    std::mutex mailbox_mutex_;
+    std::condition_variable mailbox_cv_;
+    bool has_pending_ = false;
+    FrameBuffer staging_;   // capture thread only
+    FrameBuffer pending_;   // guarded by mailbox_mutex_
+    FrameBuffer working_;   // sender thread only
+    FrameBuffer previous_;  // sender thread only: last frame sent, for tile diffs
+    std::uint32_t next_frame_index_ = 0;
+    int frames_since_keyframe_ = 0;
+    std::uint64_t client_connected_at_us_ = 0;  // sender thread only
+    std::vector<std::uint8_t> packet_;
+};